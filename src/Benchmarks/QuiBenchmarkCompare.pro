@@ -0,0 +1,16 @@
+TEMPLATE = app
+TARGET = StatisticAnalyzerBenchmarkCompare
+
+CONFIG += console c++17 release
+CONFIG -= app_bundle qt debug
+
+unix: LIBS += -pthread
+
+SOURCES += \
+    compare.cpp
+
+HEADERS += \
+    ../Console/batch_analyzer.h \
+    ../Console/batch_report.h \
+    benchmark.h \
+    benchmark_compare.h
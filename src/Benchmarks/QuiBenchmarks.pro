@@ -0,0 +1,46 @@
+TEMPLATE = app
+TARGET = StatisticAnalyzerBenchmarks
+
+CONFIG += console c++17 release
+CONFIG -= app_bundle qt debug
+
+# Reading of .gz and .zst sample files, e.g. qmake CONFIG+=s21_zlib CONFIG+=s21_zstd
+s21_zlib {
+    DEFINES += S21_WITH_ZLIB
+    LIBS += -lz
+}
+s21_zstd {
+    DEFINES += S21_WITH_ZSTD
+    LIBS += -lzstd
+}
+
+# Stage timers compiled out, e.g. qmake CONFIG+=s21_no_profiling
+s21_no_profiling: DEFINES += S21_NO_PROFILING
+
+unix: LIBS += -pthread
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../Console/batch_analyzer.h \
+    ../Console/batch_report.h \
+    ../Controller/laboratory_controller.h \
+    ../Generator/sample_generator.h \
+    ../Model/DataReader/data_reader.h \
+    ../Model/DataReader/decompressor.h \
+    ../Model/DataReader/delimited_parser.h \
+    ../Model/DataReader/follow_reader.h \
+    ../Model/DataReader/mapped_file.h \
+    ../Model/DataReader/number_parser.h \
+    ../Model/DataReader/parse_errors.h \
+    ../Model/DataReader/sample_cache.h \
+    ../Model/LaboratoryEngine/laboratory_engine.h \
+    ../Model/LaboratoryEngine/moment_accumulator.h \
+    ../Model/LaboratoryEngine/simd_kernels.h \
+    ../Model/LaboratoryEngine/statistic_histogram.h \
+    ../Model/LaboratoryEngine/statistic_sorter.h \
+    ../Model/Profiler/stage_profiler.h \
+    ../Model/ThreadPool/thread_pool.h \
+    ../Model/laboratory_model.h \
+    benchmark.h
@@ -0,0 +1,286 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_BENCHMARKS_BENCHMARK_H_
+#define STATISTIC_ANALYZER_BENCHMARKS_BENCHMARK_H_
+
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <algorithm>
+
+#include "../Console/batch_report.h"
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#elif defined(__linux__)
+#  include <sched.h>
+#endif
+
+namespace s21 {
+    /**
+     * @struct BenchmarkResult
+     * Результат одного замера: samples - время одного выполнения в каждом повторе (нс),\n
+     * bytes - объем обрабатываемых данных (для bytes/s)
+     */
+    struct BenchmarkResult {
+        std::string benchmark;
+        std::string distribution;
+        std::size_t size {};
+        std::size_t bytes {};
+        std::vector<double> samples;
+
+        double median() const { return BenchmarkResult::median(samples); }
+        double minimum() const { return samples.empty() ? 0 : *std::min_element(samples.begin(), samples.end()); }
+
+        /**
+         * Медиана абсолютных отклонений от медианы - устойчивая к выбросам мера разброса замеров
+         */
+        double mad() const {
+            double center = median();
+            std::vector<double> deviations;
+            deviations.reserve(samples.size());
+            for (double sample : samples)
+                deviations.push_back(std::fabs(sample - center));
+            return BenchmarkResult::median(deviations);
+        }
+
+        double nsPerElement() const { return size ? median() / static_cast<double>(size) : 0; }
+        double bytesPerSecond() const { double time = median(); return time > 0 ? static_cast<double>(bytes) * 1e9 / time : 0; }
+
+        static double median(std::vector<double> values) {
+            if (values.empty())
+                return 0;
+            auto middle = values.begin() + static_cast<std::ptrdiff_t>(values.size() / 2);
+            std::nth_element(values.begin(), middle, values.end());
+            if (values.size() % 2)
+                return *middle;
+            return (*middle + *std::max_element(values.begin(), middle)) / 2;
+        }
+    };
+
+    /**
+     * @class BenchmarkRunner\n
+     * Замеряет body() repetitions раз, setup() перед каждым выполнением в замер не входит\n
+     * Короткие выполнения повторяются внутри одного повтора, пока не наберется kMinBatchElements\n
+     * обработанных значений, в samples записывается среднее время одного выполнения\n\n
+     * untilStable(relative_mad, max_repetitions) - после repetitions повторов замер продолжается,\n
+     * пока MAD / медиана больше relative_mad, но не дольше max_repetitions повторов\n\n
+     * pinToCpus(cpus) - привязывает процесс к ядрам cpus (потоки, созданные после вызова, тоже),\n
+     * чтобы замеры не зависели от переноса потоков между ядрами\n\n
+     * Copyable, moveable, final class
+     */
+    class BenchmarkRunner final {
+    public:
+        static constexpr std::size_t kMinBatchElements = 1 << 20;
+
+    public:
+        explicit BenchmarkRunner(std::size_t repetitions = 5) : repetitions_(repetitions ? repetitions : 1) {}
+
+    public:
+        void untilStable(double relative_mad, std::size_t max_repetitions) noexcept {
+            relative_mad_ = relative_mad;
+            max_repetitions_ = max_repetitions;
+        }
+
+        static bool pinToCpus(const std::vector<std::size_t> &cpus) {
+            if (cpus.empty())
+                return false;
+#if defined(_WIN32)
+            DWORD_PTR mask = 0;
+            for (std::size_t cpu : cpus) {
+                if (cpu >= sizeof(DWORD_PTR) * 8)
+                    return false;
+                mask |= static_cast<DWORD_PTR>(1) << cpu;
+            }
+            return SetProcessAffinityMask(GetCurrentProcess(), mask) != 0;
+#elif defined(__linux__)
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (std::size_t cpu : cpus) {
+                if (cpu >= CPU_SETSIZE)
+                    return false;
+                CPU_SET(cpu, &set);
+            }
+            return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+            return false;
+#endif
+        }
+
+    public:
+        template <typename Setup, typename Body>
+        BenchmarkResult measure(std::string benchmark, std::string distribution, std::size_t size, std::size_t bytes,
+                                Setup &&setup, Body &&body) const {
+            BenchmarkResult result{std::move(benchmark), std::move(distribution), size, bytes, {}};
+            std::size_t iterations = std::max<std::size_t>(1, kMinBatchElements / std::max<std::size_t>(size, 1));
+            while (result.samples.size() < repetitions_ or (relative_mad_ > 0 and result.samples.size() < max_repetitions_
+                                                            and result.mad() > relative_mad_ * result.median())) {
+                double total = 0;
+                for (std::size_t iteration = 0; iteration != iterations; ++iteration) {
+                    setup();
+                    auto start = std::chrono::steady_clock::now();
+                    body();
+                    total += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+                }
+                result.samples.push_back(total / static_cast<double>(iterations));
+            }
+            return result;
+        }
+
+        std::size_t repetitions() const noexcept { return repetitions_; }
+
+        /**
+         * Не дает компилятору выбросить вычисление, результат которого не используется
+         */
+        template <typename T>
+        static void doNotOptimize(const T &value) {
+#if defined(__GNUC__)
+            asm volatile("" : : "r,m"(value) : "memory");
+#else
+            static volatile const void *sink;
+            sink = &value;
+#endif
+        }
+
+    private:
+        std::size_t repetitions_;
+        double relative_mad_ = 0;
+        std::size_t max_repetitions_ = 0;
+    };
+
+    enum class BenchmarkFormat { kCsv, kJson };
+
+    /**
+     * @class BenchmarkReport\n
+     * Записывает результаты в CSV (строка на замер, строки '#' - сведения о сборке) или JSON,\n
+     * читает CSV обратно (readCsv) для сравнения с базовым замером\n
+     * Static class
+     */
+    class BenchmarkReport final {
+    public:
+        static void write(std::ostream &out, const std::vector<BenchmarkResult> &results, BenchmarkFormat format) {
+            if (format == BenchmarkFormat::kCsv)
+                writeCsv(out, results);
+            else
+                writeJson(out, results);
+        }
+
+        static void writeCsv(std::ostream &out, const std::vector<BenchmarkResult> &results) {
+            out << "# compiler: " << compiler() << '\n';
+            out << "benchmark,distribution,size,bytes,repetitions,median_ns,mad_ns,min_ns,ns_per_element,bytes_per_second,samples_ns\n";
+            for (const auto &result : results) {
+                out << result.benchmark << ',' << result.distribution << ',' << result.size << ',' << result.bytes
+                    << ',' << result.samples.size() << ',' << number(result.median()) << ',' << number(result.mad())
+                    << ',' << number(result.minimum()) << ',' << number(result.nsPerElement()) << ',' << number(result.bytesPerSecond()) << ',';
+                for (std::size_t index = 0; index != result.samples.size(); ++index)
+                    out << (index ? ";" : "") << number(result.samples[index]);
+                out << '\n';
+            }
+        }
+
+        static void writeJson(std::ostream &out, const std::vector<BenchmarkResult> &results) {
+            out << "{\"compiler\": \"" << compiler() << "\", \"results\": [";
+            for (std::size_t index = 0; index != results.size(); ++index) {
+                const auto &result = results[index];
+                out << (index ? ",\n  " : "\n  ") << "{\"benchmark\": \"" << result.benchmark << "\", \"distribution\": \"" << result.distribution
+                    << "\", \"size\": " << result.size << ", \"bytes\": " << result.bytes << ", \"repetitions\": " << result.samples.size()
+                    << ", \"median_ns\": " << number(result.median()) << ", \"mad_ns\": " << number(result.mad())
+                    << ", \"min_ns\": " << number(result.minimum()) << ", \"ns_per_element\": " << number(result.nsPerElement())
+                    << ", \"bytes_per_second\": " << number(result.bytesPerSecond()) << ", \"samples_ns\": [";
+                for (std::size_t sample = 0; sample != result.samples.size(); ++sample)
+                    out << (sample ? ", " : "") << number(result.samples[sample]);
+                out << "]}";
+            }
+            out << (results.empty() ? "]}\n" : "\n]}\n");
+        }
+
+        /**
+         * @brief readCsv
+         * Читает результаты, записанные writeCsv: столбцы ищутся по заголовку, строки '#' пропускаются\n
+         * Если столбца samples_ns нет, замер восстанавливается из median_ns
+         * @return
+         * false, если нет заголовка или нужных столбцов
+         */
+        static bool readCsv(std::istream &in, std::vector<BenchmarkResult> &results) {
+            std::vector<std::string> header;
+            for (std::string line; std::getline(in, line);) {
+                if (!line.empty() and line.back() == '\r')
+                    line.pop_back();
+                if (line.empty() or line.front() == '#')
+                    continue;
+                auto fields = split(line, ',');
+                if (header.empty()) {
+                    header = std::move(fields);
+                    continue;
+                }
+                auto field = [&header, &fields](const char *name) -> std::string {
+                    auto column = std::find(header.begin(), header.end(), name);
+                    auto index = static_cast<std::size_t>(column - header.begin());
+                    return column != header.end() and index < fields.size() ? fields[index] : std::string();
+                };
+                BenchmarkResult result;
+                result.benchmark = field("benchmark");
+                result.distribution = field("distribution");
+                result.size = static_cast<std::size_t>(std::strtoull(field("size").c_str(), nullptr, 10));
+                result.bytes = static_cast<std::size_t>(std::strtoull(field("bytes").c_str(), nullptr, 10));
+                for (const auto &sample : split(field("samples_ns"), ';'))
+                    result.samples.push_back(std::strtod(sample.c_str(), nullptr));
+                if (result.samples.empty() and !field("median_ns").empty())
+                    result.samples.push_back(std::strtod(field("median_ns").c_str(), nullptr));
+                if (result.benchmark.empty() or result.samples.empty())
+                    return false;
+                results.push_back(std::move(result));
+            }
+            return !header.empty();
+        }
+
+    private:
+        static std::vector<std::string> split(const std::string &text, char separator) {
+            std::vector<std::string> items;
+            if (text.empty())
+                return items;
+            for (std::size_t begin = 0;;) {
+                std::size_t end = text.find(separator, begin);
+                items.push_back(text.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+                if (end == std::string::npos)
+                    return items;
+                begin = end + 1;
+            }
+        }
+
+        static std::string number(double value) {
+            std::string text = BatchReport::number(value);
+            return text.empty() ? "0" : text;
+        }
+
+        static const char *compiler() noexcept {
+#if defined(__clang__)
+            return "clang " __clang_version__;
+#elif defined(__GNUC__)
+            return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+            return "msvc";
+#else
+            return "unknown";
+#endif
+        }
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_BENCHMARKS_BENCHMARK_H_
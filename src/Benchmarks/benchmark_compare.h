@@ -0,0 +1,118 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_BENCHMARKS_BENCHMARK_COMPARE_H_
+#define STATISTIC_ANALYZER_BENCHMARKS_BENCHMARK_COMPARE_H_
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+
+namespace s21 {
+    /**
+     * @struct BenchmarkComparison
+     * Сравнение замера с базовым: change - относительное изменение медианы (0.1 - на 10% медленнее),\n
+     * score - изменение медианы в единицах разброса обоих замеров (оценка сигмы по MAD)
+     */
+    struct BenchmarkComparison {
+        enum class Status { kOk, kNoise, kRegression, kImprovement, kMissing, kNew };
+
+        std::string benchmark;
+        std::string distribution;
+        std::size_t size {};
+        double baseline_ns {};
+        double current_ns {};
+        double change {};
+        double score {};
+        Status status = Status::kOk;
+    };
+
+    /**
+     * @class BenchmarkComparator\n
+     * Сравнивает результаты двух запусков StatisticAnalyzerBenchmarks по (benchmark, distribution, size)\n\n
+     * Замер считается регрессией, если его медиана выросла больше чем на threshold и это изменение\n
+     * значимо: больше sigma оценок сигмы разброса, sigma = 1.4826 * sqrt(MAD_base^2 + MAD_current^2)\n
+     * Изменение больше threshold, но в пределах разброса - kNoise (нужно больше повторов)\n\n
+     * Copyable, moveable, final class
+     */
+    class BenchmarkComparator final {
+    public:
+        static constexpr double kMadToSigma = 1.4826; // Для нормально распределенных замеров
+
+    public:
+        explicit BenchmarkComparator(double threshold = 0.1, double sigma = 3) : threshold_(threshold), sigma_(sigma) {}
+
+    public:
+        std::vector<BenchmarkComparison> compare(const std::vector<BenchmarkResult> &baseline, const std::vector<BenchmarkResult> &current) const {
+            std::vector<BenchmarkComparison> comparisons;
+            std::vector<bool> matched(current.size());
+            for (const auto &base : baseline) {
+                BenchmarkComparison comparison{base.benchmark, base.distribution, base.size, base.median(), 0, 0, 0,
+                                               BenchmarkComparison::Status::kMissing};
+                for (std::size_t index = 0; index != current.size(); ++index) {
+                    const auto &result = current[index];
+                    if (matched[index] or result.benchmark != base.benchmark or result.distribution != base.distribution or result.size != base.size)
+                        continue;
+                    matched[index] = true;
+                    compare(base, result, comparison);
+                    break;
+                }
+                comparisons.push_back(comparison);
+            }
+            for (std::size_t index = 0; index != current.size(); ++index) {
+                if (!matched[index])
+                    comparisons.push_back(BenchmarkComparison{current[index].benchmark, current[index].distribution, current[index].size,
+                                                              0, current[index].median(), 0, 0, BenchmarkComparison::Status::kNew});
+            }
+            return comparisons;
+        }
+
+        static const char *statusName(BenchmarkComparison::Status status) noexcept {
+            switch (status) {
+                case BenchmarkComparison::Status::kOk:          return "ok";
+                case BenchmarkComparison::Status::kNoise:       return "noise";
+                case BenchmarkComparison::Status::kRegression:  return "REGRESSION";
+                case BenchmarkComparison::Status::kImprovement: return "improvement";
+                case BenchmarkComparison::Status::kMissing:     return "missing";
+                case BenchmarkComparison::Status::kNew:         return "new";
+            }
+            return "";
+        }
+
+    private:
+        double threshold_, sigma_;
+
+    private:
+        void compare(const BenchmarkResult &base, const BenchmarkResult &result, BenchmarkComparison &comparison) const {
+            comparison.current_ns = result.median();
+            double difference = comparison.current_ns - comparison.baseline_ns;
+            comparison.change = comparison.baseline_ns > 0 ? difference / comparison.baseline_ns : 0;
+            double spread = kMadToSigma * std::hypot(base.mad(), result.mad());
+            if (spread > 0)
+                comparison.score = difference / spread;
+            else
+                comparison.score = difference > 0 ? std::numeric_limits<double>::infinity() : difference < 0 ? -std::numeric_limits<double>::infinity() : 0;
+
+            using Status = BenchmarkComparison::Status;
+            if (std::fabs(comparison.change) <= threshold_)
+                comparison.status = Status::kOk;
+            else if (std::fabs(comparison.score) <= sigma_)
+                comparison.status = Status::kNoise;
+            else
+                comparison.status = comparison.change > 0 ? Status::kRegression : Status::kImprovement;
+        }
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_BENCHMARKS_BENCHMARK_COMPARE_H_
@@ -0,0 +1,96 @@
+/** Statistic analyzer sourse-main file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#include "benchmark_compare.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    const char *kUsage =
+        "Usage: StatisticAnalyzerBenchmarkCompare [options] <baseline.csv> <current.csv>\n"
+        "Compares two StatisticAnalyzerBenchmarks CSV results, exits with 1 if a regression is found\n\n"
+        "Options:\n"
+        "  --threshold P         slowdown of the median in percent that counts as a regression (default: 10)\n"
+        "  --sigma K             the slowdown must also exceed K MAD-based sigmas of both runs (default: 3)\n"
+        "  --fail-on-missing     also fail if a baseline measurement is absent from the current run\n"
+        "  -q, --quiet           print only measurements that are not ok\n"
+        "  -h, --help            show this help\n";
+
+    bool parsePositive(const char *text, double &value) {
+        char *end = nullptr;
+        value = std::strtod(text, &end);
+        return end != text and !*end and value >= 0;
+    }
+
+    bool read(const std::string &path, std::vector<s21::BenchmarkResult> &results) {
+        std::ifstream fin(path);
+        if (!fin.is_open() or !s21::BenchmarkReport::readCsv(fin, results)) {
+            std::cerr << "Cannot read benchmark results: " << path << '\n';
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    double threshold = 10, sigma = 3;
+    bool fail_on_missing = false, quiet = false;
+    std::vector<std::string> paths;
+
+    for (int index = 1; index < argc; ++index) {
+        std::string argument = argv[index];
+        if (argument == "-h" or argument == "--help") {
+            std::cout << kUsage;
+            return 0;
+        } else if ((argument == "--threshold" or argument == "--sigma") and index + 1 < argc) {
+            if (!parsePositive(argv[++index], argument == "--threshold" ? threshold : sigma)) {
+                std::cerr << "Invalid value of " << argument << ": " << argv[index] << '\n';
+                return 2;
+            }
+        } else if (argument == "--fail-on-missing") {
+            fail_on_missing = true;
+        } else if (argument == "-q" or argument == "--quiet") {
+            quiet = true;
+        } else if (argument.size() > 1 and argument[0] == '-') {
+            std::cerr << "Unknown option: " << argument << "\n\n" << kUsage;
+            return 2;
+        } else {
+            paths.push_back(argument);
+        }
+    }
+    if (paths.size() != 2) {
+        std::cerr << kUsage;
+        return 2;
+    }
+
+    std::vector<s21::BenchmarkResult> baseline, current;
+    if (!read(paths[0], baseline) or !read(paths[1], current))
+        return 2;
+
+    using Status = s21::BenchmarkComparison::Status;
+    s21::BenchmarkComparator comparator(threshold / 100, sigma);
+    std::size_t regressions = 0, missing = 0;
+    std::printf("%-16s %-12s %12s %14s %14s %9s %9s  %s\n", "benchmark", "distribution", "size", "baseline_ns", "current_ns", "change", "sigmas", "status");
+    for (const auto &comparison : comparator.compare(baseline, current)) {
+        regressions += comparison.status == Status::kRegression;
+        missing += comparison.status == Status::kMissing;
+        if (quiet and comparison.status == Status::kOk)
+            continue;
+        std::printf("%-16s %-12s %12zu %14.1f %14.1f %+8.1f%% %+9.1f  %s\n", comparison.benchmark.c_str(), comparison.distribution.c_str(),
+                    comparison.size, comparison.baseline_ns, comparison.current_ns, comparison.change * 100, comparison.score,
+                    s21::BenchmarkComparator::statusName(comparison.status));
+    }
+    std::printf("%zu regression(s), %zu missing measurement(s)\n", regressions, missing);
+    return regressions or (fail_on_missing and missing) ? 1 : 0;
+}
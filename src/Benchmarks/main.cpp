@@ -0,0 +1,250 @@
+/** Statistic analyzer sourse-main file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#include "benchmark.h"
+#include "../Model/DataReader/data_reader.h"
+#include "../Model/LaboratoryEngine/laboratory_engine.h"
+#include "../Generator/sample_generator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+
+namespace {
+    const char *kUsage =
+        "Usage: StatisticAnalyzerBenchmarks [options]\n"
+        "Measures reading, sorting, intervals, moments and graph data of LaboratoryStatisticEngine\n\n"
+        "Options:\n"
+        "  --min-size N          smallest sample size (default: 1e3)\n"
+        "  --max-size N          largest sample size, sizes grow tenfold (default: 1e7, up to 1e9)\n"
+        "  --repetitions N       repetitions of every measurement (default: 5)\n"
+        "  --until-stable P      repeat until MAD is at most P percent of the median (default: off)\n"
+        "  --max-repetitions N   repetitions limit of --until-stable (default: 30)\n"
+        "  --pin-cpus LIST       comma separated CPUs the benchmark runs on, e.g. 2 or 2,3\n"
+        "  --benchmarks LIST     comma separated: read,sort,sort_serial,sort_parallel,sort_radix,intervals,moments,\n"
+        "                        graph_statistic,graph_normal (default: all)\n"
+        "  --distributions LIST  comma separated: normal,lognormal,bimodal,heavy,quantized,sorted (default: all)\n"
+        "  --format FORMAT       csv or json (default: csv)\n"
+        "  -o, --output PATH     write results to PATH instead of stdout\n"
+        "  -h, --help            show this help\n";
+
+    const std::vector<std::string> kBenchmarks = {"read", "sort", "sort_serial", "sort_parallel", "sort_radix", "intervals", "moments",
+                                                  "graph_statistic", "graph_normal"};
+    const std::vector<std::string> kDistributions = [] {
+        std::vector<std::string> names;
+        for (auto distribution : s21::SampleGenerator::kDistributions)
+            names.emplace_back(s21::SampleGenerator::distributionName(distribution));
+        return names;
+    }();
+    constexpr std::size_t kIntervalsCount = 10;
+
+    std::vector<std::string> split(const std::string &list) {
+        std::vector<std::string> items;
+        std::stringstream stream(list);
+        for (std::string item; std::getline(stream, item, ',');)
+            if (!item.empty())
+                items.push_back(item);
+        return items;
+    }
+
+    bool contains(const std::vector<std::string> &items, const std::string &item) {
+        return std::find(items.begin(), items.end(), item) != items.end();
+    }
+
+    bool parseSize(const char *text, std::size_t &size) {
+        char *end = nullptr;
+        double value = std::strtod(text, &end); // Допускает запись 1e9
+        if (end == text or *end or !(value >= 1) or value > 1e12)
+            return false;
+        size = static_cast<std::size_t>(value);
+        return true;
+    }
+
+    std::vector<double> generate(const std::string &distribution, std::size_t size, std::uint64_t seed) {
+        s21::SampleDistribution kind = s21::SampleDistribution::kNormal;
+        s21::SampleGenerator::parseDistribution(distribution, kind);
+        return s21::SampleGenerator(kind, seed, size).generate(size);
+    }
+
+    std::size_t writeText(const std::string &path, const std::vector<double> &values) {
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            return 0;
+        std::size_t bytes = 0;
+        {
+            s21::SampleWriter writer(file, s21::SampleFileFormat::kText);
+            writer.write(values);
+            writer.flush();
+            bytes = writer.bytes();
+        }
+        std::fclose(file);
+        return bytes;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    using s21::BenchmarkRunner;
+    using s21::LaboratoryStatisticEngine;
+
+    std::size_t min_size = 1000, max_size = 10000000, repetitions = 5, max_repetitions = 30;
+    double stable_percent = 0;
+    std::vector<std::size_t> cpus;
+    std::vector<std::string> benchmarks = kBenchmarks, distributions = kDistributions;
+    s21::BenchmarkFormat format = s21::BenchmarkFormat::kCsv;
+    std::string output_path;
+
+    for (int index = 1; index < argc; ++index) {
+        std::string argument = argv[index];
+        auto value = [&]() -> const char * {
+            if (index + 1 == argc) {
+                std::cerr << "Option " << argument << " requires a value\n";
+                std::exit(2);
+            }
+            return argv[++index];
+        };
+        bool valid = true;
+        if (argument == "-h" or argument == "--help") {
+            std::cout << kUsage;
+            return 0;
+        } else if (argument == "--min-size") {
+            valid = parseSize(value(), min_size);
+        } else if (argument == "--max-size") {
+            valid = parseSize(value(), max_size);
+        } else if (argument == "--repetitions") {
+            valid = parseSize(value(), repetitions);
+        } else if (argument == "--max-repetitions") {
+            valid = parseSize(value(), max_repetitions);
+        } else if (argument == "--until-stable") {
+            char *end = nullptr;
+            stable_percent = std::strtod(value(), &end);
+            valid = end != argv[index] and !*end and stable_percent > 0;
+        } else if (argument == "--pin-cpus") {
+            for (const auto &cpu : split(value())) {
+                valid = valid and cpu.size() < 5 and cpu.find_first_not_of("0123456789") == std::string::npos;
+                cpus.push_back(static_cast<std::size_t>(std::atoi(cpu.c_str())));
+            }
+            valid = valid and !cpus.empty();
+        } else if (argument == "--benchmarks") {
+            benchmarks = split(value());
+            valid = std::all_of(benchmarks.begin(), benchmarks.end(), [](const auto &name) { return contains(kBenchmarks, name); });
+        } else if (argument == "--distributions") {
+            distributions = split(value());
+            valid = std::all_of(distributions.begin(), distributions.end(), [](const auto &name) { return contains(kDistributions, name); });
+        } else if (argument == "--format") {
+            std::string name = value();
+            valid = name == "csv" or name == "json";
+            format = name == "json" ? s21::BenchmarkFormat::kJson : s21::BenchmarkFormat::kCsv;
+        } else if (argument == "-o" or argument == "--output") {
+            output_path = value();
+        } else {
+            std::cerr << "Unknown option: " << argument << "\n\n" << kUsage;
+            return 2;
+        }
+        if (!valid) {
+            std::cerr << "Invalid value of " << argument << ": " << argv[index] << '\n';
+            return 2;
+        }
+    }
+
+    // До создания потоков пула: они наследуют привязку к ядрам
+    if (!cpus.empty() and !BenchmarkRunner::pinToCpus(cpus)) {
+        std::cerr << "Cannot pin the benchmark to the given CPUs\n";
+        return 2;
+    }
+    BenchmarkRunner runner(repetitions);
+    if (stable_percent > 0)
+        runner.untilStable(stable_percent / 100, std::max(max_repetitions, repetitions));
+    std::vector<s21::BenchmarkResult> results;
+    auto temporary = std::filesystem::temp_directory_path();
+
+    for (const auto &distribution : distributions) {
+        for (std::size_t size = min_size; size <= max_size; size = size > max_size / 10 ? max_size + 1 : size * 10) {
+            std::cerr << distribution << ' ' << size << "...\n";
+            const auto data = generate(distribution, size, size);
+            const std::size_t bytes = size * sizeof(double);
+            LaboratoryStatisticEngine engine;
+            std::size_t intervals_count = kIntervalsCount;
+            auto nextLayout = [&engine, &intervals_count] { // Сбрасывает кэши интервалов и графиков
+                intervals_count = intervals_count == kIntervalsCount ? kIntervalsCount + 1 : kIntervalsCount;
+                engine.intervalsCount(intervals_count);
+            };
+
+            if (contains(benchmarks, "read")) {
+                std::string path = (temporary / ("s21_benchmark_" + distribution + "_" + std::to_string(size) + ".txt")).string();
+                std::size_t file_size = writeText(path, data);
+                results.push_back(runner.measure("read", distribution, size, file_size, [] {}, [&path] {
+                    auto statistic = s21::NormalDistributionStatisticReader::read(path);
+                    BenchmarkRunner::doNotOptimize(statistic.data());
+                }));
+                std::filesystem::remove(path);
+            }
+            // Сортируется копия выборки: engine.statistic() помечает уже отсортированные данные,
+            // и sortStatistic() на распределении sorted ничего бы не делал
+            std::vector<double> scratch;
+            if (contains(benchmarks, "sort")) {
+                results.push_back(runner.measure("sort", distribution, size, bytes, [&scratch, &data] { scratch = data; }, [&engine, &scratch] {
+                    engine.sorter().sort(scratch);
+                    BenchmarkRunner::doNotOptimize(scratch.data());
+                }));
+            }
+            for (auto backend : s21::StatisticSorter::kBackends) { // sort_serial, sort_parallel, sort_radix
+                std::string name = std::string("sort_") + s21::StatisticSorter::backendName(backend);
+                if (!contains(benchmarks, name))
+                    continue;
+                s21::StatisticSorter sorter;
+                sorter.backend(backend);
+                sorter.parallelThreshold(0); // Параллельный путь на любом размере, а не только от 1 << 20 значений
+                results.push_back(runner.measure(name, distribution, size, bytes, [&scratch, &data] { scratch = data; }, [&sorter, &scratch] {
+                    sorter.sort(scratch);
+                    BenchmarkRunner::doNotOptimize(scratch.data());
+                }));
+            }
+            if (contains(benchmarks, "moments")) {
+                results.push_back(runner.measure("moments", distribution, size, bytes, [&engine, &data] { engine.statistic(data); }, [&engine] {
+                    BenchmarkRunner::doNotOptimize(engine.statisticMean());
+                    BenchmarkRunner::doNotOptimize(engine.statisticMeanQuadraticDeviation());
+                }));
+            }
+
+            engine.statistic(data);
+            engine.sortStatistic();
+            if (contains(benchmarks, "intervals")) {
+                results.push_back(runner.measure("intervals", distribution, size, bytes, nextLayout, [&engine] {
+                    engine.buildIntervals();
+                }));
+            }
+            if (contains(benchmarks, "graph_statistic")) {
+                results.push_back(runner.measure("graph_statistic", distribution, size, bytes, [&] { nextLayout(); engine.buildIntervals(); }, [&engine] {
+                    BenchmarkRunner::doNotOptimize(engine.graphStatisticData().first.data());
+                }));
+            }
+            if (contains(benchmarks, "graph_normal")) {
+                results.push_back(runner.measure("graph_normal", distribution, size, bytes, nextLayout, [&engine] {
+                    BenchmarkRunner::doNotOptimize(engine.graphNormalDistributionData().first.data());
+                }));
+            }
+        }
+    }
+
+    std::ofstream fout;
+    if (!output_path.empty()) {
+        fout.open(output_path);
+        if (!fout.is_open()) {
+            std::cerr << "Cannot open output file: " << output_path << '\n';
+            return 2;
+        }
+    }
+    s21::BenchmarkReport::write(output_path.empty() ? std::cout : fout, results, format);
+    return 0;
+}
@@ -0,0 +1,16 @@
+TEMPLATE = app
+TARGET = StatisticAnalyzerChecks
+
+CONFIG += console c++17
+CONFIG -= app_bundle qt
+
+unix: LIBS += -pthread
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../Model/DataReader/data_reader.h \
+    ../Model/DataReader/follow_reader.h \
+    ../Model/DataReader/number_parser.h \
+    ../Model/DataReader/parse_errors.h
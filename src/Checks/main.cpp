@@ -0,0 +1,130 @@
+/** Statistic analyzer sourse-main file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#include "../Model/DataReader/follow_reader.h"
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iterator>
+#include <filesystem>
+
+namespace {
+    struct SplitCase {
+        std::string text;
+        s21::NumberFormat format;
+        std::vector<double> expected;
+    };
+
+    std::string show(const std::vector<double> &values) {
+        std::ostringstream out;
+        for (double value : values)
+            out << value << ' ';
+        return out.str();
+    }
+
+    /**
+     * Текст разбирается двумя блоками, разрезанными на каждом смещении: незаконченное значение в конце\n
+     * первого блока должно переноситься во второй, результат - совпадать с разбором целиком
+     */
+    bool checkBlockSplits(const SplitCase &test) {
+        for (std::size_t split = 0; split <= test.text.size(); ++split) {
+            s21::NumberParser parser(test.format);
+            std::vector<double> values;
+            auto sink = [&values](double value) { values.push_back(value); };
+            const char *begin = test.text.data(), *middle = begin + split;
+            const char *stop = parser.parse(begin, middle, false, sink);
+            std::string rest = std::string(stop, middle) + test.text.substr(split);
+            if (!parser.stopped())
+                parser.parse(rest.data(), rest.data() + rest.size(), true, sink);
+            if (parser.stopped() or values != test.expected) {
+                std::cerr << "FAILED split of \"" << test.text << "\" at " << split << ": " << show(values)
+                          << (parser.stopped() ? "(stopped)" : "") << '\n';
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Ожидаемые значения записей в формате по умолчанию сверяются с operator>>(double)
+     */
+    bool checkAgainstStream(const SplitCase &test) {
+        std::istringstream in(test.text);
+        std::vector<double> values{std::istream_iterator<double>(in), std::istream_iterator<double>()};
+        if (values == test.expected)
+            return true;
+        std::cerr << "FAILED istream_iterator of \"" << test.text << "\": " << show(values) << '\n';
+        return false;
+    }
+
+    void appendToFile(const std::string &path, const std::string &text) {
+        std::ofstream fout(path, std::ios::binary | std::ios::app);
+        fout << text;
+    }
+
+    /**
+     * Файл дописывается двумя частями, разрезанными на каждом смещении, после каждой части - FollowReader::poll():\n
+     * частично записанное значение должно дождаться продолжения, а не разбираться по своему началу
+     */
+    bool checkFollowSplits(const SplitCase &test, const std::string &path) {
+        s21::ReadOptions options;
+        options.number_format = test.format;
+        for (std::size_t split = 0; split <= test.text.size(); ++split) {
+            std::remove(path.c_str());
+            appendToFile(path, test.text.substr(0, split));
+            s21::FollowReader reader(path, options);
+            std::vector<double> values;
+            reader.poll(values);
+            appendToFile(path, test.text.substr(split));
+            reader.poll(values);
+            appendToFile(path, "\n"); // Последнее значение учитывается после разделителя
+            reader.poll(values);
+            if (reader.stopped() or values != test.expected) {
+                std::cerr << "FAILED follow of \"" << test.text << "\" split at " << split << ": " << show(values)
+                          << (reader.stopped() ? "(stopped)" : "") << '\n';
+                std::remove(path.c_str());
+                return false;
+            }
+        }
+        std::remove(path.c_str());
+        return true;
+    }
+}
+
+int main() {
+    const std::vector<SplitCase> cases = {
+        {"1.5e+10 2 3\n", {}, {1.5e10, 2, 3}},
+        {"-2.5E-3\n4 1e2", {}, {-2.5e-3, 4, 1e2}},
+        {"1,234.5 7\n-12,345,678", {'.', ','}, {1234.5, 7, -12345678}},
+    };
+    std::size_t failed = 0;
+    for (const auto &test : cases) {
+        if (test.format.isDefault() and !checkAgainstStream(test))
+            ++failed;
+        if (!checkBlockSplits(test))
+            ++failed;
+    }
+    std::string follow_path = (std::filesystem::temp_directory_path() / "statistic_analyzer_follow_check.txt").string();
+    const std::vector<SplitCase> follow_cases = {
+        {"1 2 1.5e+10 3", {}, {1, 2, 1.5e10, 3}},
+        {"7 1,234.5 8", {'.', ','}, {7, 1234.5, 8}},
+    };
+    for (const auto &test : follow_cases)
+        if (!checkFollowSplits(test, follow_path))
+            ++failed;
+    std::cout << (failed ? "FAILED: " : "ok: ") << cases.size() << " block split cases, " << follow_cases.size()
+              << " follow cases, " << failed << " failures\n";
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,50 @@
+TEMPLATE = app
+TARGET = StatisticAnalyzerConsole
+
+CONFIG += console c++17
+CONFIG -= app_bundle qt
+
+# Reading of .gz and .zst sample files, e.g. qmake CONFIG+=s21_zlib CONFIG+=s21_zstd
+s21_zlib {
+    DEFINES += S21_WITH_ZLIB
+    LIBS += -lz
+}
+s21_zstd {
+    DEFINES += S21_WITH_ZSTD
+    LIBS += -lzstd
+}
+
+# Stage timers compiled out, e.g. qmake CONFIG+=s21_no_profiling
+s21_no_profiling: DEFINES += S21_NO_PROFILING
+
+unix: LIBS += -pthread
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../Controller/laboratory_controller.h \
+    ../Model/DataReader/data_reader.h \
+    ../Model/DataReader/decompressor.h \
+    ../Model/DataReader/delimited_parser.h \
+    ../Model/DataReader/follow_reader.h \
+    ../Model/DataReader/mapped_file.h \
+    ../Model/DataReader/number_parser.h \
+    ../Model/DataReader/parse_errors.h \
+    ../Model/DataReader/sample_cache.h \
+    ../Model/LaboratoryEngine/laboratory_engine.h \
+    ../Model/LaboratoryEngine/moment_accumulator.h \
+    ../Model/LaboratoryEngine/simd_kernels.h \
+    ../Model/LaboratoryEngine/statistic_histogram.h \
+    ../Model/LaboratoryEngine/statistic_sorter.h \
+    ../Model/Profiler/allocation_counter.h \
+    ../Model/Profiler/stage_profiler.h \
+    ../Model/ThreadPool/thread_pool.h \
+    ../Model/laboratory_model.h \
+    batch_analyzer.h \
+    batch_report.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
@@ -0,0 +1,223 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_CONSOLE_BATCH_ANALYZER_H_
+#define STATISTIC_ANALYZER_CONSOLE_BATCH_ANALYZER_H_
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+
+#include "../Controller/laboratory_controller.h"
+#include "../Model/ThreadPool/thread_pool.h"
+#include "../Model/Profiler/stage_profiler.h"
+
+namespace s21 {
+    /**
+     * @struct BatchOptions
+     * intervals_count - на сколько интервалов разбивается каждая выборка (0 - не разбивается)\n
+     * column - столбец CSV/TSV файлов (пустой - первый числовой), jobs - сколько файлов обрабатывается одновременно\n
+     * sample_cache - использовать SampleCache, skip_invalid - пропускать некорректные значения, а не прекращать чтение\n
+     * profile - записывать стадии обработки каждого файла в BatchResult::profile, sort_backend - способ сортировки выборок
+     */
+    struct BatchOptions {
+        std::size_t intervals_count = 0;
+        std::string column;
+        std::size_t jobs = ThreadPool::defaultThreadsCount();
+        bool sample_cache = true;
+        bool skip_invalid = true;
+        bool profile = false;
+        StatisticSorter::Backend sort_backend = StatisticSorter::Backend::kParallel;
+    };
+
+    /**
+     * @struct BatchInterval
+     * Интервал выборки [left, right): количество значений n и доля n/N
+     */
+    struct BatchInterval {
+        double left, right;
+        std::size_t count;
+        double relative;
+    };
+
+    /**
+     * @struct BatchResult
+     * Результат обработки одного файла, error - описание ошибки (пустое, если файл обработан)\n
+     * profile - стадии чтения и обработки (при BatchOptions::profile); выделения памяти считаются только в потоке,\n
+     * обрабатывающем файл, поэтому соседние файлы при jobs > 1 в них не попадают, но и выделения частей\n
+     * параллельного чтения и сортировки на ThreadPool тоже не учитываются (allocs занижен для многопоточных стадий)
+     */
+    struct BatchResult {
+        std::string path;
+        std::string error;
+        StatisticSummary summary;
+        NumberFormat number_format;
+        std::size_t skipped {};
+        std::vector<BatchInterval> intervals;
+        StageProfile profile;
+
+        bool ok() const noexcept { return error.empty(); }
+    };
+
+    /**
+     * @class BatchAnalyzer\n
+     * Пакетная обработка файлов выборок без графического интерфейса:\n
+     * каждый файл читается, сортируется и (при intervals_count) разбивается на интервалы\n
+     * собственным LaboratoryController, файлы обрабатываются параллельно на ThreadPool\n\n
+     * expandPaths(patterns) - раскрывает шаблоны с '*' и '?' в имени файла (не в каталогах)\n\n
+     * Non-copyable, moveable, final class
+     */
+    class BatchAnalyzer final {
+    public:
+        explicit BatchAnalyzer(const BatchOptions &options = {}) : options_(options) {
+            if (!options_.jobs)
+                options_.jobs = 1;
+        }
+
+    public:
+        /**
+         * @brief analyze
+         * Обрабатывает files, не больше options.jobs файлов одновременно
+         * @return
+         * Результаты в порядке files
+         */
+        std::vector<BatchResult> analyze(const std::vector<std::string> &files) const {
+            std::vector<BatchResult> results(files.size());
+            if (options_.jobs == 1 or files.size() < 2) {
+                for (std::size_t index = 0; index != files.size(); ++index)
+                    results[index] = analyzeFile(files[index]);
+                return results;
+            }
+            ThreadPool pool(std::min(options_.jobs, files.size()) - 1); // Вызывающий поток тоже обрабатывает файлы
+            pool.parallelFor(files.size(), [this, &files, &results](std::size_t index) {
+                results[index] = analyzeFile(files[index]);
+            });
+            return results;
+        }
+
+        BatchResult analyzeFile(const std::string &path) const {
+            BatchResult result;
+            result.path = path;
+            std::error_code error;
+            if (!std::filesystem::is_regular_file(path, error)) {
+                result.error = "cannot open file";
+                return result;
+            }
+
+            ProfileSession session(result.profile, options_.profile);
+            LaboratoryController controller;
+            controller.setSampleCacheEnabled(options_.sample_cache);
+            controller.setSkipInvalidValues(options_.skip_invalid);
+            controller.setSortBackend(options_.sort_backend);
+            if (!options_.column.empty())
+                controller.setReadColumns({options_.column});
+            if (options_.jobs > 1) { // Файлы уже обрабатываются параллельно
+                controller.setReadThreadsCount(1);
+                controller.setSortThreadsCount(1);
+            }
+            try {
+                controller.readStatisticFromFile(path);
+                const auto &report = controller.getReadReport();
+                result.number_format = report.number_format;
+                result.skipped = report.skipped;
+                if (report.decompression_failed) {
+                    result.error = compressionSupported(report.compression) ? "corrupted compressed data"
+                                                                            : "compression is not supported by this build";
+                    return result;
+                }
+                if (report.stopped) {
+                    result.error = "invalid value";
+                    if (!report.errors.empty())
+                        result.error += " at line " + std::to_string(report.errors.front().line);
+                    return result;
+                }
+                if (!controller.statisticIsGood()) {
+                    result.error = report.binary ? "corrupted binary sample" : "no values";
+                    return result;
+                }
+                controller.sortStatistic();
+                result.summary = controller.getStatisticSummary();
+                if (options_.intervals_count) {
+                    controller.buildStatisticIntervals(options_.intervals_count);
+                    const auto &borders = controller.getIntervalsBorderValues();
+                    const auto &ranges = controller.getStatisticIntervals();
+                    const auto &relative = controller.getIntervalsRelativeAmount();
+                    for (std::size_t interval = 0; interval != ranges.size(); ++interval)
+                        result.intervals.push_back(BatchInterval{borders[interval].first, borders[interval].second,
+                                                                 ranges[interval].second, relative[interval]});
+                }
+            } catch (const std::exception &exception) {
+                result.error = exception.what();
+            }
+            return result;
+        }
+
+        /**
+         * @brief expandPaths
+         * Пути без '*' и '?' остаются как есть, шаблон заменяется отсортированными файлами своего каталога,\n
+         * имена которых ему соответствуют (кроме файлов кэша .sab)
+         */
+        static std::vector<std::string> expandPaths(const std::vector<std::string> &patterns) {
+            std::vector<std::string> files;
+            for (const auto &pattern : patterns) {
+                std::filesystem::path path(pattern);
+                std::string name = path.filename().string();
+                if (name.find_first_of("*?") == std::string::npos) {
+                    files.push_back(pattern);
+                    continue;
+                }
+                std::filesystem::path directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+                std::vector<std::string> matches;
+                std::error_code error;
+                for (std::filesystem::directory_iterator entry(directory, error), end; !error and entry != end; entry.increment(error)) {
+                    std::error_code status_error;
+                    if (!entry->is_regular_file(status_error) or entry->path().extension() == ".sab") // Файлы SampleCache
+                        continue;
+                    if (matchWildcard(name, entry->path().filename().string()))
+                        matches.push_back(path.has_parent_path() ? entry->path().string() : entry->path().filename().string());
+                }
+                std::sort(matches.begin(), matches.end());
+                files.insert(files.end(), matches.begin(), matches.end());
+            }
+            return files;
+        }
+
+        static bool matchWildcard(const std::string &pattern, const std::string &name) noexcept {
+            std::size_t current = 0, position = 0;
+            std::size_t star = std::string::npos, star_position = 0;
+            while (position != name.size()) {
+                if (current != pattern.size() and (pattern[current] == '?' or pattern[current] == name[position])) {
+                    ++current, ++position;
+                } else if (current != pattern.size() and pattern[current] == '*') {
+                    star = current++;
+                    star_position = position;
+                } else if (star != std::string::npos) {
+                    current = star + 1;
+                    position = ++star_position;
+                } else {
+                    return false;
+                }
+            }
+            while (current != pattern.size() and pattern[current] == '*')
+                ++current;
+            return current == pattern.size();
+        }
+
+        const BatchOptions &options() const noexcept { return options_; }
+
+    private:
+        BatchOptions options_;
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_CONSOLE_BATCH_ANALYZER_H_
@@ -0,0 +1,186 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_CONSOLE_BATCH_REPORT_H_
+#define STATISTIC_ANALYZER_CONSOLE_BATCH_REPORT_H_
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <charconv>
+#include <ostream>
+
+#include "batch_analyzer.h"
+
+namespace s21 {
+    enum class BatchFormat { kJson, kCsv };
+
+    /**
+     * @class BatchReport\n
+     * Записывает результаты BatchAnalyzer в поток:\n
+     * a) kJson - массив объектов, по одному на файл, интервалы - вложенным массивом\n
+     * b) kCsv  - строка на файл, интервалы - столбцами n_1..n_k (количества значений)\n\n
+     * При profile стадии обработки файла записываются массивом profile (JSON) или столбцом profile вида\n
+     * "read=12.5;read/parse=11.9" в миллисекундах (CSV)\n\n
+     * Числа записываются кратчайшей точной записью, NaN и бесконечности - null (JSON) или пустой ячейкой (CSV)\n\n
+     * Static class
+     */
+    class BatchReport final {
+    public:
+        static void write(std::ostream &out, const std::vector<BatchResult> &results, BatchFormat format, std::size_t intervals_count = 0,
+                          bool profile = false) {
+            if (format == BatchFormat::kJson)
+                writeJson(out, results, profile);
+            else
+                writeCsv(out, results, intervals_count, profile);
+        }
+
+        static void writeJson(std::ostream &out, const std::vector<BatchResult> &results, bool profile = false) {
+            out << "[";
+            for (std::size_t index = 0; index != results.size(); ++index) {
+                const auto &result = results[index];
+                out << (index ? ",\n  {" : "\n  {") << "\"file\": " << jsonString(result.path);
+                if (!result.ok()) {
+                    out << ", \"error\": " << jsonString(result.error);
+                    if (profile)
+                        writeJsonProfile(out, result.profile);
+                    out << "}";
+                    continue;
+                }
+                const auto &summary = result.summary;
+                out << ", \"count\": " << summary.count << ", \"sum\": " << jsonNumber(summary.sum)
+                    << ", \"mean\": " << jsonNumber(summary.mean) << ", \"deviation\": " << jsonNumber(std::sqrt(summary.variance))
+                    << ", \"variance\": " << jsonNumber(summary.variance) << ", \"minimum\": " << jsonNumber(summary.minimum)
+                    << ", \"maximum\": " << jsonNumber(summary.maximum) << ", \"skewness\": " << jsonNumber(summary.skewness)
+                    << ", \"kurtosis\": " << jsonNumber(summary.kurtosis) << ", \"skipped\": " << result.skipped;
+                if (!result.intervals.empty()) {
+                    out << ", \"intervals\": [";
+                    for (std::size_t interval = 0; interval != result.intervals.size(); ++interval) {
+                        const auto &current = result.intervals[interval];
+                        out << (interval ? ", " : "") << "{\"left\": " << jsonNumber(current.left) << ", \"right\": " << jsonNumber(current.right)
+                            << ", \"n\": " << current.count << ", \"relative\": " << jsonNumber(current.relative) << "}";
+                    }
+                    out << "]";
+                }
+                if (profile)
+                    writeJsonProfile(out, result.profile);
+                out << "}";
+            }
+            out << (results.empty() ? "]\n" : "\n]\n");
+        }
+
+        static void writeCsv(std::ostream &out, const std::vector<BatchResult> &results, std::size_t intervals_count = 0, bool profile = false) {
+            out << "file,count,sum,mean,deviation,variance,minimum,maximum,skewness,kurtosis,skipped";
+            for (std::size_t interval = 1; interval <= intervals_count; ++interval)
+                out << ",n_" << interval;
+            out << (profile ? ",profile,error\n" : ",error\n");
+            for (const auto &result : results) {
+                out << csvString(result.path);
+                if (!result.ok()) {
+                    out << std::string(10 + intervals_count, ',');
+                    if (profile)
+                        out << ',' << csvString(csvProfile(result.profile));
+                    out << ',' << csvString(result.error) << '\n';
+                    continue;
+                }
+                const auto &summary = result.summary;
+                out << ',' << summary.count << ',' << number(summary.sum) << ',' << number(summary.mean)
+                    << ',' << number(std::sqrt(summary.variance)) << ',' << number(summary.variance)
+                    << ',' << number(summary.minimum) << ',' << number(summary.maximum)
+                    << ',' << number(summary.skewness) << ',' << number(summary.kurtosis) << ',' << result.skipped;
+                for (std::size_t interval = 0; interval != intervals_count; ++interval) {
+                    out << ',';
+                    if (interval < result.intervals.size())
+                        out << result.intervals[interval].count;
+                }
+                if (profile)
+                    out << ',' << csvString(csvProfile(result.profile));
+                out << ",\n";
+            }
+        }
+
+        /**
+         * Кратчайшая запись value, однозначно восстанавливающая его при чтении, пустая строка для NaN и бесконечностей
+         */
+        static std::string number(double value) {
+            if (!std::isfinite(value))
+                return {};
+            char buffer[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            return error == std::errc() ? std::string(buffer, end) : std::string();
+#else
+            std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+            return buffer;
+#endif
+        }
+
+    private:
+        static void writeJsonProfile(std::ostream &out, const StageProfile &profile) {
+            out << ", \"profile\": [";
+            for (std::size_t index = 0; index != profile.stages().size(); ++index) {
+                const auto &stage = profile.stages()[index];
+                out << (index ? ", " : "") << "{\"stage\": " << jsonString(profile.path(index)) << ", \"ms\": " << jsonNumber(stage.milliseconds())
+                    << ", \"calls\": " << stage.calls << ", \"elements\": " << stage.elements;
+                if (AllocationCounter::installed)
+                    out << ", \"allocations\": " << stage.allocations;
+                out << "}";
+            }
+            out << "]";
+        }
+
+        static std::string csvProfile(const StageProfile &profile) {
+            std::string text;
+            for (std::size_t index = 0; index != profile.stages().size(); ++index)
+                text += (index ? ";" : "") + profile.path(index) + '=' + number(profile.stages()[index].milliseconds());
+            return text;
+        }
+
+        static std::string jsonNumber(double value) {
+            std::string text = number(value);
+            return text.empty() ? "null" : text;
+        }
+
+        static std::string jsonString(const std::string &text) {
+            std::string quoted = "\"";
+            for (char symbol : text) {
+                switch (symbol) {
+                    case '"':  quoted += "\\\""; break;
+                    case '\\': quoted += "\\\\"; break;
+                    case '\n': quoted += "\\n"; break;
+                    case '\r': quoted += "\\r"; break;
+                    case '\t': quoted += "\\t"; break;
+                    default:
+                        if (static_cast<unsigned char>(symbol) < 0x20) {
+                            char escaped[8];
+                            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(symbol));
+                            quoted += escaped;
+                        } else {
+                            quoted += symbol;
+                        }
+                }
+            }
+            return quoted + '"';
+        }
+
+        static std::string csvString(const std::string &text) {
+            if (text.find_first_of(",\"\r\n") == std::string::npos)
+                return text;
+            std::string quoted = "\"";
+            for (char symbol : text)
+                quoted += symbol == '"' ? std::string("\"\"") : std::string(1, symbol);
+            return quoted + '"';
+        }
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_CONSOLE_BATCH_REPORT_H_
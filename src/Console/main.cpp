@@ -0,0 +1,155 @@
+/** Statistic analyzer sourse-main file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#include "batch_analyzer.h"
+#include "batch_report.h"
+#include "../Model/Profiler/allocation_counter.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    const char *kUsage =
+        "Usage: StatisticAnalyzerConsole [options] <file|pattern>...\n"
+        "Analyzes sample files without GUI, patterns may contain '*' and '?' in the file name\n\n"
+        "Options:\n"
+        "  -i, --intervals N     split every sample into N intervals (default: do not split)\n"
+        "  -f, --format FORMAT   json or csv (default: json)\n"
+        "  -j, --jobs N          files processed simultaneously (default: number of cores)\n"
+        "  -c, --column NAME     column of CSV/TSV files (default: first numeric column)\n"
+        "  -o, --output PATH     write results to PATH instead of stdout\n"
+        "      --strict          stop reading a file at the first invalid value\n"
+        "      --no-cache        do not read or write .sab sample caches\n"
+        "      --sort-backend B  serial, parallel or radix (default: parallel)\n"
+        "      --profile         add stage timings of every file to the results and print their totals to stderr\n"
+        "  -h, --help            show this help\n";
+
+    bool parseCount(const char *text, std::size_t &count) {
+        char *end = nullptr;
+        unsigned long long value = std::strtoull(text, &end, 10);
+        if (end == text or *end or text[0] == '-')
+            return false;
+        count = static_cast<std::size_t>(value);
+        return true;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    s21::BatchOptions options;
+    s21::BatchFormat format = s21::BatchFormat::kJson;
+    std::string output_path;
+    std::vector<std::string> patterns;
+
+    for (int index = 1; index < argc; ++index) {
+        std::string argument = argv[index];
+        auto value = [&]() -> const char * {
+            if (index + 1 == argc) {
+                std::cerr << "Option " << argument << " requires a value\n";
+                std::exit(2);
+            }
+            return argv[++index];
+        };
+        if (argument == "-h" or argument == "--help") {
+            std::cout << kUsage;
+            return 0;
+        } else if (argument == "-i" or argument == "--intervals") {
+            if (!parseCount(value(), options.intervals_count)) {
+                std::cerr << "Invalid intervals count: " << argv[index] << '\n';
+                return 2;
+            }
+        } else if (argument == "-j" or argument == "--jobs") {
+            if (!parseCount(value(), options.jobs) or !options.jobs) {
+                std::cerr << "Invalid jobs count: " << argv[index] << '\n';
+                return 2;
+            }
+        } else if (argument == "-f" or argument == "--format") {
+            std::string name = value();
+            if (name == "json") {
+                format = s21::BatchFormat::kJson;
+            } else if (name == "csv") {
+                format = s21::BatchFormat::kCsv;
+            } else {
+                std::cerr << "Unknown format: " << name << '\n';
+                return 2;
+            }
+        } else if (argument == "-c" or argument == "--column") {
+            options.column = value();
+        } else if (argument == "-o" or argument == "--output") {
+            output_path = value();
+        } else if (argument == "--strict") {
+            options.skip_invalid = false;
+        } else if (argument == "--no-cache") {
+            options.sample_cache = false;
+        } else if (argument == "--sort-backend") {
+            std::string name = value();
+            if (!s21::StatisticSorter::parseBackend(name, options.sort_backend)) {
+                std::cerr << "Unknown sort backend: " << name << '\n';
+                return 2;
+            }
+        } else if (argument == "--profile") {
+            options.profile = true;
+        } else if (argument.size() > 1 and argument[0] == '-') {
+            std::cerr << "Unknown option: " << argument << "\n\n" << kUsage;
+            return 2;
+        } else {
+            patterns.push_back(argument);
+        }
+    }
+
+    auto files = s21::BatchAnalyzer::expandPaths(patterns);
+    if (files.empty()) {
+        std::cerr << (patterns.empty() ? "No input files\n\n" : "No files match the given patterns\n") << (patterns.empty() ? kUsage : "");
+        return 2;
+    }
+
+    s21::BatchAnalyzer analyzer(options);
+    auto start = std::chrono::steady_clock::now();
+    auto results = analyzer.analyze(files);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ofstream fout;
+    if (!output_path.empty()) {
+        fout.open(output_path);
+        if (!fout.is_open()) {
+            std::cerr << "Cannot open output file: " << output_path << '\n';
+            return 2;
+        }
+    }
+    std::ostream &out = output_path.empty() ? std::cout : fout;
+    s21::BatchReport::write(out, results, format, options.intervals_count, options.profile);
+    out.flush();
+
+    std::size_t failed = 0, values = 0;
+    for (const auto &result : results) {
+        if (!result.ok())
+            ++failed;
+        values += result.summary.count;
+    }
+    char summary[256];
+    std::snprintf(summary, sizeof(summary), "%zu files (%zu failed), %zu values in %.3f s: %.1f files/s, %d jobs\n",
+                  results.size(), failed, values, seconds, seconds > 0 ? static_cast<double>(results.size()) / seconds : 0.0,
+                  static_cast<int>(std::min(analyzer.options().jobs, results.size())));
+    std::cerr << summary;
+    if (options.profile) {
+#if defined(S21_NO_PROFILING)
+        std::cerr << "Stage timers are compiled out (S21_NO_PROFILING)\n";
+#else
+        s21::StageProfile total;
+        for (const auto &result : results)
+            total.merge(result.profile);
+        total.report(std::cerr);
+#endif
+    }
+    return failed ? 1 : 0;
+}
@@ -25,10 +25,23 @@ namespace s21 {
         using statistic_type = LaboratoryStatisticEngine::statistic_type;
         using statistic_value_type = LaboratoryStatisticEngine::statistic_value_type;
         using statistic_size_type = LaboratoryStatisticEngine::statistic_size_type;
+        using interval_range_type = LaboratoryStatisticEngine::interval_range_type;
 
     public:
         void readStatisticFromFile(const std::string &path) { model_->readStatisticFromFile(path); }
+        bool followStatisticFile(const std::string &path) { return model_->followStatisticFile(path); }
+        bool pollFollowedFile() { return model_->pollFollowedFile(); }
+        void stopFollowing() { model_->stopFollowing(); }
+        [[nodiscard]] bool isFollowing() const noexcept { return model_->isFollowing(); }
+        void setReadThreadsCount(const statistic_size_type &threads_count) { model_->setReadThreadsCount(threads_count); }
+        void setSampleCacheEnabled(bool enabled) { model_->setSampleCacheEnabled(enabled); }
+        void setReadColumns(std::vector<std::string> columns) { model_->setReadColumns(std::move(columns)); }
+        [[nodiscard]] std::vector<std::string> getColumnNames(const std::string &path) const { return model_->getColumnNames(path); }
+        void setNumberFormat(std::optional<NumberFormat> number_format) { model_->setNumberFormat(number_format); }
+        void setSkipInvalidValues(bool skip) { model_->setSkipInvalidValues(skip); }
         void sortStatistic() { model_->sortStatistic(); }
+        void setSortBackend(StatisticSorter::Backend backend) { model_->setSortBackend(backend); }
+        void setSortThreadsCount(const statistic_size_type &threads_count) { model_->setSortThreadsCount(threads_count); }
         void buildStatisticIntervals(const statistic_size_type &intervals_count) { model_->buildStatisticIntervals(intervals_count); }
 
         void showStatistic(std::ostream &out, char sep = '\t') const { model_->showStatistic(out, sep); }
@@ -37,13 +50,25 @@ namespace s21 {
         [[nodiscard]] statistic_value_type getStatisticMeanValue() const { return model_->getStatisticMeanValue(); }
         [[nodiscard]] statistic_value_type getStatisticMeanQuadraticDeviationValue() const { return model_->getStatisticMeanQuadraticDeviationValue(); }
         [[nodiscard]] statistic_value_type getStatisticSum() const { return model_->getStatisticSum(); }
+        [[nodiscard]] StatisticSummary getStatisticSummary() const { return model_->getStatisticSummary(); }
+        [[nodiscard]] const ReadReport &getReadReport() const noexcept { return model_->getReadReport(); }
+        [[nodiscard]] StatisticHistogram getStatisticHistogram(const statistic_size_type &bins_count) const { return model_->getStatisticHistogram(bins_count); }
+        [[nodiscard]] StatisticSummary streamStatisticSummary(const std::string &path) const { return model_->streamStatisticSummary(path); }
+        [[nodiscard]] StatisticHistogram streamStatisticHistogram(const std::string &path, const statistic_size_type &bins_count) const {
+            return model_->streamStatisticHistogram(path, bins_count);
+        }
         [[nodiscard]] statistic_size_type  getStatisticSize() const noexcept { return model_->getStatisticSize(); }
         [[nodiscard]] statistic_size_type  getStatisticIntervalsCount() const noexcept { return model_->getStatisticIntervalsCount(); }
+        [[nodiscard]] const std::vector<std::pair<statistic_value_type, statistic_value_type>> &getIntervalsBorderValues() const noexcept {
+            return model_->getIntervalsBorderValues();
+        }
+        [[nodiscard]] const std::vector<interval_range_type> &getStatisticIntervals() const noexcept { return model_->getStatisticIntervals(); }
+        [[nodiscard]] const statistic_type &getIntervalsRelativeAmount() const noexcept { return model_->getIntervalsRelativeAmount(); }
         [[nodiscard]] const statistic_type &getStatistic() const noexcept { return model_->getStatistic(); }
         [[nodiscard]] statistic_value_type getStatisticMinimumValue() const noexcept { return model_->getStatisticMinimumValue(); }
         [[nodiscard]] statistic_value_type getStatisticMaximumValue() const noexcept { return model_->getStatisticMaximumValue(); }
-        [[nodiscard]] std::pair<statistic_type, statistic_type> getGraphStatisticData() const { return model_->getGraphStatisticData(); }
-        [[nodiscard]] std::pair<statistic_type, statistic_type> getGraphNormalDistributionData() const { return model_->getGraphNormalDistributionData(); }
+        [[nodiscard]] const std::pair<statistic_type, statistic_type> &getGraphStatisticData() const { return model_->getGraphStatisticData(); }
+        [[nodiscard]] const std::pair<statistic_type, statistic_type> &getGraphNormalDistributionData() const { return model_->getGraphNormalDistributionData(); }
 
         [[nodiscard]] bool statisticIsGood() const noexcept { return model_->statisticIsGood(); }
 
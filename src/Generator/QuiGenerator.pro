@@ -0,0 +1,12 @@
+TEMPLATE = app
+TARGET = StatisticAnalyzerGenerator
+
+CONFIG += console c++17 release
+CONFIG -= app_bundle qt debug
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../Model/DataReader/sample_cache.h \
+    sample_generator.h
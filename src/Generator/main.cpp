@@ -0,0 +1,161 @@
+/** Statistic analyzer sourse-main file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#include "sample_generator.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#if defined(_WIN32)
+#  include <io.h>
+#  include <fcntl.h>
+#endif
+
+namespace {
+    const char *kUsage =
+        "Usage: StatisticAnalyzerGenerator [options] <count>\n"
+        "Writes count synthetic sample values (1e9 notation is allowed), the same seed gives the same file\n\n"
+        "Options:\n"
+        "  -d, --distribution D  normal, lognormal, bimodal, heavy, quantized or sorted (default: normal)\n"
+        "  -s, --seed N          seed of the random generator (default: 1)\n"
+        "  --mean M              center of the distribution (default: 10)\n"
+        "  --deviation S         scale of the distribution (default: 1)\n"
+        "  --step Q              rounding step of quantized values (default: 1)\n"
+        "  -f, --format FORMAT   text or binary - .sab sample with header and checksum, requires --output (default: text)\n"
+        "  -p, --precision N     digits after the decimal point in text (default: 6)\n"
+        "  --separator SEP       newline, space or tab between text values (default: newline)\n"
+        "  -o, --output PATH     write to PATH instead of stdout\n"
+        "  -h, --help            show this help\n";
+
+    bool parseNumber(const char *text, double &value) {
+        char *end = nullptr;
+        value = std::strtod(text, &end);
+        return end != text and !*end and std::isfinite(value);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    s21::SampleDistribution distribution = s21::SampleDistribution::kNormal;
+    s21::SampleParameters parameters;
+    s21::SampleFileFormat format = s21::SampleFileFormat::kText;
+    std::uint64_t seed = 1;
+    int precision = 6;
+    char separator = '\n';
+    std::string output_path;
+    double count = -1;
+
+    for (int index = 1; index < argc; ++index) {
+        std::string argument = argv[index];
+        if (argument == "-h" or argument == "--help") {
+            std::cout << kUsage;
+            return 0;
+        }
+        bool valid = true;
+        if (argument.size() > 1 and argument[0] == '-') {
+            if (index + 1 == argc) {
+                std::cerr << "Option " << argument << " requires a value\n";
+                return 2;
+            }
+            std::string value = argv[++index];
+            double number = 0;
+            if (argument == "-d" or argument == "--distribution") {
+                valid = s21::SampleGenerator::parseDistribution(value, distribution);
+            } else if (argument == "-s" or argument == "--seed") {
+                valid = !value.empty() and value.find_first_not_of("0123456789") == std::string::npos;
+                seed = std::strtoull(value.c_str(), nullptr, 10);
+            } else if (argument == "--mean") {
+                valid = parseNumber(value.c_str(), parameters.mean);
+            } else if (argument == "--deviation") {
+                valid = parseNumber(value.c_str(), parameters.deviation) and parameters.deviation > 0;
+            } else if (argument == "--step") {
+                valid = parseNumber(value.c_str(), parameters.step) and parameters.step > 0;
+            } else if (argument == "-f" or argument == "--format") {
+                valid = value == "text" or value == "binary";
+                format = value == "binary" ? s21::SampleFileFormat::kBinary : s21::SampleFileFormat::kText;
+            } else if (argument == "-p" or argument == "--precision") {
+                valid = parseNumber(value.c_str(), number) and number >= 0 and number <= s21::SampleWriter::kMaxPrecision;
+                precision = static_cast<int>(number);
+            } else if (argument == "--separator") {
+                valid = value == "newline" or value == "space" or value == "tab";
+                separator = value == "space" ? ' ' : value == "tab" ? '\t' : '\n';
+            } else if (argument == "-o" or argument == "--output") {
+                output_path = value;
+            } else {
+                std::cerr << "Unknown option: " << argument << "\n\n" << kUsage;
+                return 2;
+            }
+        } else {
+            valid = parseNumber(argument.c_str(), count) and count >= 0 and count < 1e15;
+        }
+        if (!valid) {
+            std::cerr << "Invalid argument: " << argument << ' ' << argv[index] << '\n';
+            return 2;
+        }
+    }
+    if (count < 0) {
+        std::cerr << kUsage;
+        return 2;
+    }
+    if (distribution == s21::SampleDistribution::kLognormal and parameters.mean <= 0) {
+        std::cerr << "Lognormal distribution requires a positive mean\n";
+        return 2;
+    }
+    if (format == s21::SampleFileFormat::kBinary and output_path.empty()) {
+        std::cerr << "Binary format requires --output: the header is written after the values\n";
+        return 2;
+    }
+
+    std::FILE *file = stdout;
+    if (!output_path.empty()) {
+        file = std::fopen(output_path.c_str(), "wb");
+        if (!file) {
+            std::cerr << "Cannot open output file: " << output_path << '\n';
+            return 2;
+        }
+    } else {
+#if defined(_WIN32)
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    }
+
+    auto total = static_cast<std::size_t>(count);
+    auto start = std::chrono::steady_clock::now();
+    s21::SampleGenerator generator(distribution, seed, total, parameters);
+    std::size_t bytes = 0;
+    bool written = true;
+    {
+        s21::SampleWriter writer(file, format, precision, separator);
+        std::vector<double> block(1 << 16);
+        for (std::size_t done = 0; done < total and written;) {
+            std::size_t size = generator.generate(block.data(), std::min(block.size(), total - done));
+            written = writer.write(block.data(), size);
+            done += size;
+        }
+        written = writer.finish(distribution == s21::SampleDistribution::kSorted) and written;
+        bytes = writer.bytes();
+    }
+    if (file != stdout)
+        written = std::fclose(file) == 0 and written;
+    else
+        written = std::fflush(stdout) == 0 and written;
+    if (!written) {
+        std::cerr << "Write error\n";
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    char summary[256];
+    std::snprintf(summary, sizeof(summary), "%zu %s values, %zu bytes in %.3f s: %.1f MB/s\n", total,
+                  s21::SampleGenerator::distributionName(distribution), bytes, seconds, seconds > 0 ? static_cast<double>(bytes) / seconds / 1e6 : 0.0);
+    std::cerr << summary;
+    return 0;
+}
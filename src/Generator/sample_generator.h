@@ -0,0 +1,493 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_GENERATOR_SAMPLE_GENERATOR_H_
+#define STATISTIC_ANALYZER_GENERATOR_SAMPLE_GENERATOR_H_
+
+#include <cmath>
+#include <array>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include "../Model/DataReader/sample_cache.h"
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+namespace s21 {
+    /**
+     * @class Xoshiro256Lanes\n
+     * kLanes независимых генераторов xoshiro256+ (Blackman, Vigna), состояние хранится по словам (s[word][lane]),\n
+     * fill() продвигает полосы по две в регистре SSE2 (без SSE2 - тот же цикл по полосам на скалярах)\n
+     * Полосы инициализируются из seed через splitmix64, последовательность полностью определяется seed\n\n
+     * Copyable, moveable, final class
+     */
+    class Xoshiro256Lanes final {
+    public:
+        static constexpr std::size_t kLanes = 4;
+
+    public:
+        explicit Xoshiro256Lanes(std::uint64_t seed = 0) noexcept {
+            for (std::size_t lane = 0; lane != kLanes; ++lane)
+                for (std::size_t word = 0; word != 4; ++word)
+                    state_[word][lane] = splitMix64(seed);
+        }
+
+    public:
+        /**
+         * Записывает count случайных чисел (count кратно kLanes): out[i] - из полосы i % kLanes
+         */
+        void fill(std::uint64_t *out, std::size_t count) noexcept {
+#if defined(__SSE2__)
+            // Две полосы в одном регистре: у SSE2 есть 64-битные сложение и сдвиги, нет только вращения
+            __m128i s0[2], s1[2], s2[2], s3[2];
+            for (std::size_t half = 0; half != 2; ++half) {
+                s0[half] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state_[0] + 2 * half));
+                s1[half] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state_[1] + 2 * half));
+                s2[half] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state_[2] + 2 * half));
+                s3[half] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state_[3] + 2 * half));
+            }
+            for (std::size_t index = 0; index + kLanes <= count; index += kLanes) {
+                for (std::size_t half = 0; half != 2; ++half) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + index + 2 * half), _mm_add_epi64(s0[half], s3[half]));
+                    __m128i t = _mm_slli_epi64(s1[half], 17);
+                    s2[half] = _mm_xor_si128(s2[half], s0[half]);
+                    s3[half] = _mm_xor_si128(s3[half], s1[half]);
+                    s1[half] = _mm_xor_si128(s1[half], s2[half]);
+                    s0[half] = _mm_xor_si128(s0[half], s3[half]);
+                    s2[half] = _mm_xor_si128(s2[half], t);
+                    s3[half] = _mm_or_si128(_mm_slli_epi64(s3[half], 45), _mm_srli_epi64(s3[half], 19));
+                }
+            }
+            for (std::size_t half = 0; half != 2; ++half) {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(state_[0] + 2 * half), s0[half]);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(state_[1] + 2 * half), s1[half]);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(state_[2] + 2 * half), s2[half]);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(state_[3] + 2 * half), s3[half]);
+            }
+#else
+            auto &s0 = state_[0], &s1 = state_[1], &s2 = state_[2], &s3 = state_[3];
+            for (std::size_t index = 0; index + kLanes <= count; index += kLanes) {
+                for (std::size_t lane = 0; lane != kLanes; ++lane) {
+                    out[index + lane] = s0[lane] + s3[lane];
+                    std::uint64_t t = s1[lane] << 17;
+                    s2[lane] ^= s0[lane];
+                    s3[lane] ^= s1[lane];
+                    s1[lane] ^= s2[lane];
+                    s0[lane] ^= s3[lane];
+                    s2[lane] ^= t;
+                    s3[lane] = (s3[lane] << 45) | (s3[lane] >> 19);
+                }
+            }
+#endif
+        }
+
+        /**
+         * Равномерное на (0, 1] по старшим 53 битам (младшие биты xoshiro256+ слабее)
+         */
+        static double toUnit(std::uint64_t bits) noexcept { return static_cast<double>((bits >> 11) + 1) * 0x1.0p-53; }
+
+    private:
+        std::uint64_t state_[4][kLanes];
+
+    private:
+        static std::uint64_t splitMix64(std::uint64_t &seed) noexcept {
+            std::uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+    };
+
+    enum class SampleDistribution { kNormal, kLognormal, kBimodal, kHeavyTailed, kQuantized, kSorted };
+
+    /**
+     * @struct SampleParameters
+     * mean и deviation - центр и масштаб распределения, step - шаг округления kQuantized (1 - целые числа)
+     */
+    struct SampleParameters {
+        double mean = 10;
+        double deviation = 1;
+        double step = 1;
+    };
+
+    /**
+     * @class SampleGenerator\n
+     * Поток синтетических значений, одинаковый для одинаковых (distribution, seed, count, parameters)\n
+     * независимо от того, какими блоками он читается generate()\n\n
+     * a) kNormal     - N(mean, deviation), метод зиккурата\n
+     * b) kLognormal  - exp(N(ln mean, deviation / mean)): медиана mean, коэффициент вариации около deviation / mean\n
+     * c) kBimodal    - смесь N(mean -+ 2 deviation, deviation) с равными весами\n
+     * d) kHeavyTailed - симметричный хвост Парето с показателем kHeavyTailAlpha (дисперсия конечна, эксцесс - нет)\n
+     * e) kQuantized  - N(mean, deviation), округленное до кратного step (показания прибора с ценой деления)\n
+     * f) kSorted     - N(mean, deviation) сразу в порядке возрастания: порядковые статистики равномерного\n
+     *                  распределения строятся последовательно и переводятся обратной функцией нормального распределения,\n
+     *                  поэтому выборка любого размера генерируется потоком без сортировки\n\n
+     * count нужен только kSorted (размер всей выборки), для остальных generate() не ограничен\n\n
+     * Copyable, moveable, final class
+     */
+    class SampleGenerator final {
+    public:
+        static constexpr double kHeavyTailAlpha = 3;
+        static constexpr std::size_t kZigguratLayers = 128;
+        static constexpr double kZigguratR = 3.442619855899;        // Начало хвоста
+        static constexpr double kZigguratV = 9.91256303526217e-3;   // Площадь слоя
+        static constexpr std::size_t kBufferSize = 1024; // Случайных чисел, генерируемых за раз
+
+    public:
+        SampleGenerator(SampleDistribution distribution, std::uint64_t seed, std::size_t count = 0, const SampleParameters &parameters = {})
+            : distribution_(distribution), parameters_(parameters), random_(seed), remaining_(count) {}
+
+    public:
+        /**
+         * @brief generate
+         * Записывает в out следующие size значений потока (для kSorted - не больше оставшихся)
+         * @return
+         * Количество записанных значений
+         */
+        std::size_t generate(double *out, std::size_t size) {
+            if (distribution_ == SampleDistribution::kSorted) {
+                size = std::min(size, remaining_);
+                for (std::size_t index = 0; index != size; ++index)
+                    out[index] = nextSorted();
+                return size;
+            }
+            const double mean = parameters_.mean, deviation = parameters_.deviation;
+            switch (distribution_) {
+                case SampleDistribution::kNormal:
+                    for (std::size_t index = 0; index != size; ++index)
+                        out[index] = mean + deviation * nextNormal();
+                    break;
+                case SampleDistribution::kLognormal: {
+                    double mu = std::log(mean), sigma = deviation / mean;
+                    for (std::size_t index = 0; index != size; ++index)
+                        out[index] = std::exp(mu + sigma * nextNormal());
+                    break;
+                }
+                case SampleDistribution::kBimodal:
+                    for (std::size_t index = 0; index != size; ++index) {
+                        double center = nextBits() >> 63 ? mean + 2 * deviation : mean - 2 * deviation;
+                        out[index] = center + deviation * nextNormal();
+                    }
+                    break;
+                case SampleDistribution::kHeavyTailed:
+                    for (std::size_t index = 0; index != size; ++index) {
+                        std::uint64_t bits = nextBits();
+                        double tail = deviation * (std::pow(Xoshiro256Lanes::toUnit(bits), -1 / kHeavyTailAlpha) - 1);
+                        out[index] = (bits >> 10) & 1 ? mean + tail : mean - tail; // Бит, не вошедший в toUnit, - знак
+                    }
+                    break;
+                case SampleDistribution::kQuantized: {
+                    double step = parameters_.step > 0 ? parameters_.step : 1;
+                    for (std::size_t index = 0; index != size; ++index)
+                        out[index] = std::round((mean + deviation * nextNormal()) / step) * step;
+                    break;
+                }
+                case SampleDistribution::kSorted:
+                    break;
+            }
+            return size;
+        }
+
+        std::vector<double> generate(std::size_t size) {
+            std::vector<double> values(size);
+            values.resize(generate(values.data(), size));
+            return values;
+        }
+
+        static bool parseDistribution(const std::string &name, SampleDistribution &distribution) noexcept {
+            for (auto candidate : kDistributions) {
+                if (name == distributionName(candidate)) {
+                    distribution = candidate;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static const char *distributionName(SampleDistribution distribution) noexcept {
+            switch (distribution) {
+                case SampleDistribution::kNormal:      return "normal";
+                case SampleDistribution::kLognormal:   return "lognormal";
+                case SampleDistribution::kBimodal:     return "bimodal";
+                case SampleDistribution::kHeavyTailed: return "heavy";
+                case SampleDistribution::kQuantized:   return "quantized";
+                case SampleDistribution::kSorted:      return "sorted";
+            }
+            return "";
+        }
+
+        static constexpr std::array<SampleDistribution, 6> kDistributions = {
+            SampleDistribution::kNormal, SampleDistribution::kLognormal, SampleDistribution::kBimodal,
+            SampleDistribution::kHeavyTailed, SampleDistribution::kQuantized, SampleDistribution::kSorted
+        };
+
+        /**
+         * @brief inverseNormal
+         * Обратная функция стандартного нормального распределения (Acklam, относительная погрешность 1.2e-9)\n
+         * upper = 1 - p передается отдельно, чтобы верхний хвост не терял точность при p, близком к 1
+         */
+        static double inverseNormal(double p, double upper) noexcept {
+            static constexpr double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                           1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+            static constexpr double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                           6.680131188771972e+01, -1.328068155288572e+01};
+            static constexpr double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                           -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+            static constexpr double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00, 3.754408661907416e+00};
+            static constexpr double kLow = 0.02425;
+            auto tail = [](double q) {
+                return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                       ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+            };
+            if (p < kLow)
+                return tail(std::sqrt(-2 * std::log(p)));
+            if (upper < kLow)
+                return -tail(std::sqrt(-2 * std::log(upper)));
+            double q = p - 0.5, r = q * q;
+            return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+                   (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+        }
+
+    private:
+        SampleDistribution distribution_;
+        SampleParameters parameters_;
+        Xoshiro256Lanes random_;
+        std::uint64_t buffer_[kBufferSize];
+        std::size_t position_ = kBufferSize;
+        std::size_t remaining_;                          // kSorted: сколько значений осталось
+        double log_upper_ = 0;                           // kSorted: ln(1 - U) последней порядковой статистики
+        double last_sorted_ = -HUGE_VAL;
+
+    private:
+        std::uint64_t nextBits() noexcept {
+            if (position_ == kBufferSize) {
+                random_.fill(buffer_, kBufferSize);
+                position_ = 0;
+            }
+            return buffer_[position_++];
+        }
+
+        /**
+         * Зиккурат с 128 слоями для double (Marsaglia, Tsang; вариант ZIGNOR, Doornik 2005):\n
+         * почти всегда одно случайное число и одно сравнение, exp/log - только на краях слоев и в хвосте
+         */
+        double nextNormal() noexcept {
+            const auto &table = zigguratTable();
+            while (true) {
+                std::uint64_t bits = nextBits();
+                double u = 2 * Xoshiro256Lanes::toUnit(bits) - 1;
+                std::size_t layer = (bits >> 4) & (kZigguratLayers - 1); // Биты, не вошедшие в toUnit (младшие 3 - слабые)
+                if (std::fabs(u) < table.ratio[layer])
+                    return u * table.x[layer];
+                if (layer == 0) { // Нижний слой: значение из хвоста за kZigguratR
+                    double x, y;
+                    do {
+                        x = std::log(Xoshiro256Lanes::toUnit(nextBits())) / kZigguratR;
+                        y = std::log(Xoshiro256Lanes::toUnit(nextBits()));
+                    } while (-2 * y < x * x);
+                    return u < 0 ? x - kZigguratR : kZigguratR - x;
+                }
+                double x = u * table.x[layer];
+                double f0 = std::exp(-0.5 * (table.x[layer] * table.x[layer] - x * x));
+                double f1 = std::exp(-0.5 * (table.x[layer + 1] * table.x[layer + 1] - x * x));
+                if (f1 + Xoshiro256Lanes::toUnit(nextBits()) * (f0 - f1) < 1)
+                    return x;
+            }
+        }
+
+        struct ZigguratTable {
+            double x[kZigguratLayers + 1];
+            double ratio[kZigguratLayers];
+        };
+
+        static const ZigguratTable &zigguratTable() noexcept {
+            static const ZigguratTable table = [] {
+                ZigguratTable result {};
+                double f = std::exp(-0.5 * kZigguratR * kZigguratR);
+                result.x[0] = kZigguratV / f;
+                result.x[1] = kZigguratR;
+                result.x[kZigguratLayers] = 0;
+                for (std::size_t layer = 2; layer < kZigguratLayers; ++layer) {
+                    result.x[layer] = std::sqrt(-2 * std::log(kZigguratV / result.x[layer - 1] + f));
+                    f = std::exp(-0.5 * result.x[layer] * result.x[layer]);
+                }
+                for (std::size_t layer = 0; layer != kZigguratLayers; ++layer)
+                    result.ratio[layer] = result.x[layer + 1] / result.x[layer];
+                return result;
+            }();
+            return table;
+        }
+
+        /**
+         * 1 - U(i) = (1 - U(i-1)) * V^(1 / (n - i)), V ~ U(0, 1] - i-я порядковая статистика из n равномерных
+         */
+        double nextSorted() noexcept {
+            log_upper_ += std::log(Xoshiro256Lanes::toUnit(nextBits())) / static_cast<double>(remaining_--);
+            double upper = std::exp(log_upper_);
+            double value = parameters_.mean + parameters_.deviation * inverseNormal(-std::expm1(log_upper_), upper);
+            last_sorted_ = std::max(last_sorted_, value); // Кусочная аппроксимация может не быть монотонной на стыках
+            return last_sorted_;
+        }
+    };
+
+    enum class SampleFileFormat { kText, kBinary };
+
+    /**
+     * @class SampleWriter\n
+     * Записывает значения в FILE* через собственный буфер:\n
+     * a) kText   - числа с precision знаками после точки, разделенные separator\n
+     * b) kBinary - двоичная выборка SampleCache (.sab), которую читает NormalDistributionStatisticReader:\n
+     *    заголовок с количеством, контрольной суммой и моментами, затем double; заголовок дописывается\n
+     *    в начало файла в finish(), поэтому file должен допускать перемотку (не pipe)\n\n
+     * Запись с фиксированной точностью форматируется целочисленно, без printf\n\n
+     * Non-copyable, non-moveable, final class
+     */
+    class SampleWriter final {
+    public:
+        static constexpr std::size_t kBufferSize = 1 << 20;
+        static constexpr int kMaxPrecision = 15;
+        static constexpr std::size_t kMaxLength = 512; // Длина одной записи, с запасом для "%.15f" от 1e308
+
+    public:
+        SampleWriter(std::FILE *file, SampleFileFormat format, int precision = 6, char separator = '\n')
+            : file_(file), format_(format), precision_(std::clamp(precision, 0, kMaxPrecision)), separator_(separator) {
+            buffer_.resize(kBufferSize + kMaxLength);
+            if (format_ == SampleFileFormat::kBinary)
+                used_ = SampleCache::kDataOffset; // Место под заголовок, он записывается в finish()
+        }
+
+        SampleWriter(const SampleWriter &) = delete;
+        SampleWriter(SampleWriter &&) = delete;
+        SampleWriter &operator=(const SampleWriter &) = delete;
+        SampleWriter &operator=(SampleWriter &&) = delete;
+
+        ~SampleWriter() { flush(); }
+
+    public:
+        bool write(const double *values, std::size_t size) {
+            if (format_ == SampleFileFormat::kBinary) {
+                checksum_.push(values, size);
+                moments_.push(values, size);
+                count_ += size;
+                if (!flush())
+                    return false;
+                bytes_ += size * sizeof(double);
+                return (ok_ = std::fwrite(values, sizeof(double), size, file_) == size);
+            }
+            for (std::size_t index = 0; index != size; ++index) {
+                char *end = formatFixed(values[index], precision_, buffer_.data() + used_);
+                *end++ = separator_;
+                used_ = static_cast<std::size_t>(end - buffer_.data());
+                if (used_ >= kBufferSize and !flush())
+                    return false;
+            }
+            return ok_;
+        }
+
+        bool write(const std::vector<double> &values) { return write(values.data(), values.size()); }
+
+        bool flush() {
+            if (used_) {
+                ok_ = ok_ and std::fwrite(buffer_.data(), 1, used_, file_) == used_;
+                bytes_ += used_;
+                used_ = 0;
+            }
+            return ok_;
+        }
+
+        /**
+         * @brief finish
+         * Сбрасывает буфер, для kBinary записывает заголовок в начало файла (sorted - значения упорядочены)
+         */
+        bool finish(bool sorted = false) {
+            if (!flush() or format_ != SampleFileFormat::kBinary)
+                return ok_;
+            auto header = SampleCache::header(count_, checksum_.value(), sorted, moments_);
+            ok_ = std::fseek(file_, 0, SEEK_SET) == 0 and std::fwrite(header.data(), 1, header.size(), file_) == header.size()
+                  and std::fseek(file_, 0, SEEK_END) == 0;
+            return ok_;
+        }
+
+        /**
+         * Записано байт (включая еще не сброшенные в файл)
+         */
+        std::size_t bytes() const noexcept { return bytes_ + used_; }
+
+        /**
+         * @brief formatFixed
+         * Записывает value с precision знаками после точки (как "%.*f"), возвращает конец записи\n
+         * Округляется произведение value * 10^precision, поэтому последняя цифра может отличаться от printf на единицу,\n
+         * а отрицательные значения, округлившиеся до нуля, пишутся без минуса\n
+         * Значения, не помещающиеся в 64-битное целое после умножения на 10^precision, записываются через snprintf
+         */
+        static char *formatFixed(double value, int precision, char *out) noexcept {
+            static constexpr double kPowers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+            double scaled = value * kPowers[precision];
+            if (!(std::fabs(scaled) < 9e18))
+                return out + std::snprintf(out, kMaxLength - 1, "%.*f", precision, value);
+            auto integer = static_cast<long long>(scaled + (scaled < 0 ? -0.5 : 0.5)); // Округление от нуля, как llround
+            if (integer < 0) {
+                *out++ = '-';
+                integer = -integer;
+            }
+            // Цифры пишутся с конца парами из таблицы "00".."99": деление на 100 вдвое реже деления на 10
+            static constexpr char kPairs[] =
+                "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                "8081828384858687888990919293949596979899";
+            char digits[24];
+            char *begin = digits + sizeof(digits);
+            auto rest = static_cast<unsigned long long>(integer);
+            while (rest >= 100) {
+                std::size_t pair = 2 * (rest % 100);
+                rest /= 100;
+                *--begin = kPairs[pair + 1];
+                *--begin = kPairs[pair];
+            }
+            if (rest >= 10) {
+                *--begin = kPairs[2 * rest + 1];
+                *--begin = kPairs[2 * rest];
+            } else {
+                *--begin = static_cast<char>('0' + rest);
+            }
+            while (digits + sizeof(digits) - begin <= precision)
+                *--begin = '0';
+            const char *point = digits + sizeof(digits) - precision;
+            out = std::copy(static_cast<const char *>(begin), point, out);
+            if (precision) {
+                *out++ = '.';
+                out = std::copy(point, static_cast<const char *>(digits + sizeof(digits)), out);
+            }
+            return out;
+        }
+
+    private:
+        std::FILE *file_;
+        SampleFileFormat format_;
+        int precision_;
+        char separator_;
+        std::vector<char> buffer_;
+        std::size_t used_ = 0;
+        std::size_t bytes_ = 0;
+        bool ok_ = true;
+        std::size_t count_ = 0;
+        SampleCache::Checksum checksum_;
+        MomentAccumulator moments_;
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_GENERATOR_SAMPLE_GENERATOR_H_
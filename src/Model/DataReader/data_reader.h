@@ -13,25 +13,134 @@
 #define STATISTIC_ANALYZER_MODEL_DATAREADER_DATA_READER_H_
 
 #include <vector>
+#include <algorithm>
 #include <string>
+#include <cctype>
+#include <cstring>
 #include <fstream>
-#include <iterator>
+#include <optional>
+
+#include "mapped_file.h"
+#include "decompressor.h"
+#include "number_parser.h"
+#include "sample_cache.h"
+#include "delimited_parser.h"
+#include "../ThreadPool/thread_pool.h"
+#include "../Profiler/stage_profiler.h"
 
 namespace s21 {
+    enum class ReadMode { kAuto, kMapped, kBuffered };
+    enum class DataFormat { kAuto, kText, kDelimited };
+    enum class InvalidValues { kStop, kSkip };
+
+    /**
+     * @struct ReadOptions
+     * Параметры чтения NormalDistributionStatisticReader\n
+     * threads_count - количество потоков разбора отображенного файла (0 - по количеству ядер)\n
+     * parallel_threshold - файлы меньше этого размера (в байтах) разбираются одним потоком\n
+     * format - kAuto: файлы .csv и .tsv (в том числе .csv.gz, .csv.zst) разбираются DelimitedParser, остальные - как текст\n
+     * delimiter - разделитель полей CSV ('\\0' - определяется по заголовку), columns - имена выбранных столбцов CSV\n
+     * (пусто - первый числовой столбец), read() возвращает первый из них\n
+     * number_format - десятичный разделитель и разделитель групп разрядов, std::nullopt - определяются по первому блоку файла\n
+     * invalid_values - kStop: чтение прекращается на первом некорректном значении (как у std::istream_iterator<double>),\n
+     * kSkip: некорректные значения пропускаются, их количество и позиции первых max_reported_errors попадают в ReadReport
+     */
+    struct ReadOptions {
+        ReadMode mode = ReadMode::kAuto;
+        std::size_t threads_count = 0;
+        std::size_t parallel_threshold = 1 << 24;
+        DataFormat format = DataFormat::kAuto;
+        char delimiter = '\0';
+        std::vector<std::string> columns;
+        std::optional<NumberFormat> number_format;
+        InvalidValues invalid_values = InvalidValues::kStop;
+        std::size_t max_reported_errors = 16;
+    };
+
+    /**
+     * @struct DelimitedData
+     * Результат readColumns(): все столбцы заголовка, имена выбранных столбцов и их значения в том же порядке,\n
+     * запись чисел и сведения о некорректных значениях - как в ReadReport
+     */
+    struct DelimitedData {
+        std::vector<std::string> header;
+        std::vector<std::string> names;
+        std::vector<std::vector<double>> columns;
+        NumberFormat number_format;
+        bool decompression_failed = false;
+        bool stopped = false;
+        std::size_t skipped {};
+        std::vector<ParseError> errors;
+    };
+
+    /**
+     * @struct ReadReport
+     * Сведения о последнем чтении: размер файла, оценка количества значений, под которую\n
+     * заранее резервировалась память, количество перевыделений памяти и было ли сжатие (shrink_to_fit)\n
+     * после сильно завышенной оценки, была ли это двоичная выборка SampleCache (binary), запись чисел,\n
+     * по которой был разобран файл, не удалось ли распаковать сжатый файл до конца (поврежден или формат не поддерживается сборкой,\n
+     * в выборке только распакованная часть), было ли чтение прекращено на некорректном значении (InvalidValues::kStop),\n
+     * количество пропущенных некорректных значений и позиции первых из них (InvalidValues::kSkip)
+     */
+    struct ReadReport {
+        std::size_t bytes {};
+        std::size_t values {};
+        std::size_t estimated_values {};
+        std::size_t reallocations {};
+        bool shrunk = false;
+        Compression compression = Compression::kNone;
+        bool binary = false;
+        NumberFormat number_format;
+        bool decompression_failed = false;
+        bool stopped = false;
+        std::size_t skipped {};
+        std::vector<ParseError> errors;
+    };
+
     /**
      * @class NormalDistributionStatisticReader class считывает данные
      * типа int, double, float, с файла и возвращает считанные данные в виде std::vector
      *
      * @methods
-     * a) read(const std::string &) -> static function,\n
-     *      input argument is reading file path,\n
+     * a) read(const std::string &, const ReadOptions &[, ReadReport &]) -> static function,\n
+     *      input argument is reading file path and read options (ReadMode::kAuto by default),\n
+     *      report (if passed) is filled with load instrumentation,\n
      *      output is std::vector<double> with read data,\n
      *      vector will be empty if file doesn't opened successfully
      *
      * @how_to_use
      * a) s21::NormalDistributionStatisticReader::read(path)\n
      * b) s21::NormalDistributionStatisticReader reader;\n
-     *   reader.read(path);
+     *   reader.read(path);\n
+     * c) s21::NormalDistributionStatisticReader::stream(path, [](const double *data, std::size_t size) { ... })\n
+     * d) s21::NormalDistributionStatisticReader::readHeader(path) -> столбцы CSV файла,\n
+     *   s21::NormalDistributionStatisticReader::readColumns(path, options) -> выбранные столбцы CSV файла
+     *
+     * @implementation
+     * Файл разбирается NumberParser (std::from_chars),\n
+     * разбор не зависит от локали, формат и результат совпадают с std::istream_iterator<double>:\n
+     * чтение прекращается на первом некорректном значении\n
+     * Десятичная запятая (12,5) и разделители групп разрядов (1.234,5 / 1,234.5 / 1'234.5) определяются\n
+     * NumberParser::detectFormat по первому блоку файла, если number_format не задан, и разбираются тем же быстрым путем\n
+     * ReadMode::kMapped - файл отображается в память (MappedFile), парсер идет прямо по страницам отображения\n
+     * ReadMode::kBuffered - файл читается блоками по kBlockSize байт в собственный буфер\n
+     * ReadMode::kAuto - kMapped, а если файл нельзя отобразить (pipe, пустой файл), то kBuffered\n
+     * Отображенный файл размером от parallel_threshold делится на threads_count частей, границы частей\n
+     * сдвигаются до ближайшего пробельного символа, части разбираются на ThreadPool::shared()\n
+     * и склеиваются в исходном порядке до первой части с некорректным значением - результат совпадает с разбором одним потоком\n
+     *
+     * Файлы gzip и zstd распознаются по первым байтам и распаковываются Decompressor на отдельном потоке,\n
+     * разбор идет параллельно с распаковкой, временный файл не создается\n
+     * (если формат не подключен при сборке, выборка будет пустой)\n
+     * Двоичная выборка в формате SampleCache (StatisticAnalyzerGenerator --format binary) распознается по заголовку\n
+     * отображенного файла и загружается без разбора; поврежденная (не сходится контрольная сумма) дает пустую выборку\n
+     * InvalidValues::kSkip: некорректные значения пропускаются, строки файла считаются только в этом режиме\n
+     * (ParseErrorLog): в отображенном файле - только до последней запоминаемой ошибки, в чистом файле не считаются,\n
+     * при чтении блоками и распаковке - до конца каждого блока, пока не запомнены первые max_reported_errors ошибок\n
+     * Количество значений оценивается по размеру файла и средней длине значения в первых kSampleSize байтах,\n
+     * память резервируется один раз; если зарезервировано больше kShrinkRatio * (количество значений) + kShrinkSlack\n
+     * значений, выборка сжимается\n
+     * read() записывает в активный StageProfile стадию read и вложенные parse / merge / shrink / load binary\n
      *
      * @file_structure
      * a) like this:\n 1 2 3 4 5\n
@@ -39,16 +148,466 @@ namespace s21 {
      *  1\n
      *  2\n
      *  3\n
+     * c) like this (.csv / .tsv):\n
+     *  time,part,gauge_1,gauge_2\n
+     *  12:00:01,A-17,10.02,3.5\n
      */
     class NormalDistributionStatisticReader final {
     public:
-        static std::vector<double> read(const std::string &path) {
-            std::ifstream fin(path);
+        static constexpr std::size_t kBlockSize = 1 << 20;
+        static constexpr std::size_t kStreamBlockSize = 1 << 16; // Значений в одном блоке stream()
+        static constexpr std::size_t kSampleSize = 1 << 16; // Байт, по которым оценивается длина значения
+        static constexpr double kShrinkRatio = 1.25;
+        static constexpr std::size_t kShrinkSlack = 1 << 13; // Значений (64 КБ): меньший излишек не стоит копирования выборки
+
+        static std::vector<double> read(const std::string &path, const ReadOptions &options = {}) {
+            ReadReport report;
+            return read(path, options, report);
+        }
+
+        static std::vector<double> read(const std::string &path, const ReadOptions &options, ReadReport &report) {
+            S21_PROFILE_SCOPE("read");
+            report = ReadReport{};
+            std::vector<double> statistic;
+            if (isDelimited(path, options)) {
+                auto data = readColumns(path, options);
+                if (!data.columns.empty())
+                    statistic = std::move(data.columns.front());
+                S21_PROFILE_COUNT(statistic.size());
+                report.values = report.estimated_values = statistic.size();
+                report.number_format = data.number_format;
+                report.decompression_failed = data.decompression_failed;
+                report.stopped = data.stopped;
+                report.skipped = data.skipped;
+                report.errors = std::move(data.errors);
+                return statistic;
+            }
+            if (options.mode != ReadMode::kBuffered) {
+                MappedFile file(path);
+                if (file.isOpen()) {
+                    report.compression = detectCompression(file.data(), file.size());
+                    if (SampleCache::isSample(file.data(), file.size())) {
+                        S21_PROFILE_SCOPE("load binary");
+                        report.binary = true;
+                        report.bytes = file.size();
+                        if (auto sample = SampleCache::loadSample(path)) {
+                            statistic = std::move(sample->statistic);
+                            report.estimated_values = statistic.size();
+                            report.number_format = sample->number_format;
+                        }
+                    } else if (report.compression == Compression::kNone) {
+                        statistic = readMapped(file.begin(), file.end(), options, report);
+                    } else {
+                        S21_PROFILE_SCOPE("parse compressed");
+                        report.bytes = file.size();
+                        std::size_t &reallocations = report.reallocations;
+                        NumberParser parser(options.number_format);
+                        applyErrorPolicy(parser, options);
+                        report.decompression_failed = !parseCompressed(report.compression, memoryInput(file.begin(), file.end()), parser,
+                                                                       [&statistic, &reallocations](double value) { append(statistic, value, reallocations); });
+                        S21_PROFILE_COUNT(statistic.size());
+                        report.number_format = parser.format();
+                        report.stopped = parser.stopped();
+                        reportErrors(parser.errors(), report);
+                    }
+                } else if (options.mode == ReadMode::kMapped) {
+                    return {};
+                } else {
+                    statistic = readBuffered(path, options, report);
+                }
+            } else {
+                statistic = readBuffered(path, options, report);
+            }
+            S21_PROFILE_COUNT(statistic.size());
+            report.values = statistic.size();
+            if (statistic.capacity() > static_cast<std::size_t>(kShrinkRatio * static_cast<double>(statistic.size())) + kShrinkSlack) {
+                S21_PROFILE_SCOPE("shrink");
+                statistic.shrink_to_fit();
+                report.shrunk = true;
+            }
+            return statistic;
+        }
+
+        static std::vector<double> read(const std::string &path, ReadMode mode) {
+            ReadOptions options;
+            options.mode = mode;
+            return read(path, options);
+        }
+
+        /**
+         * @brief stream
+         * Разбирает файл, не сохраняя выборку целиком: значения передаются consumer(const double *data, size_t size)\n
+         * блоками по kStreamBlockSize (последний блок короче), память не зависит от размера файла\n
+         * Файл разбирается одним потоком, threads_count не используется\n
+         * При InvalidValues::kSkip некорректные значения пропускаются, но их позиции не сообщаются
+         * @return
+         * false, если файл не открылся
+         */
+        template <typename Consumer>
+        static bool stream(const std::string &path, Consumer &&consumer, const ReadOptions &options = {}) {
+            std::vector<double> block;
+            block.reserve(kStreamBlockSize);
+            auto sink = [&block, &consumer](double value) {
+                block.push_back(value);
+                if (block.size() == kStreamBlockSize) {
+                    consumer(static_cast<const double *>(block.data()), block.size());
+                    block.clear();
+                }
+            };
+
+            bool opened, decompression_failed = false;
+            if (isDelimited(path, options)) {
+                DelimitedParser parser(options.delimiter, options.columns, options.number_format);
+                applyErrorPolicy(parser, options);
+                opened = parseFile(path, options.mode, parser, [&sink](std::size_t slot, double value) {
+                    if (!slot)
+                        sink(value);
+                }, decompression_failed);
+            } else {
+                NumberParser parser(options.number_format);
+                applyErrorPolicy(parser, options);
+                opened = parseFile(path, options.mode, parser, sink, decompression_failed);
+            }
+            if (!opened)
+                return false;
+            if (!block.empty())
+                consumer(static_cast<const double *>(block.data()), block.size());
+            return true;
+        }
+
+        /**
+         * @brief isDelimited
+         * Будет ли файл разобран как CSV / TSV при данных options
+         */
+        static bool isDelimited(const std::string &path, const ReadOptions &options = {}) {
+            if (options.format != DataFormat::kAuto)
+                return options.format == DataFormat::kDelimited;
+            std::string name = path;
+            for (const char *suffix : {".gz", ".zst"})
+                if (endsWith(name, suffix))
+                    name.erase(name.size() - std::strlen(suffix));
+            return endsWith(name, ".csv") or endsWith(name, ".tsv");
+        }
+
+        /**
+         * @brief readHeader
+         * Читает только первую строку CSV файла
+         * @return
+         * Имена столбцов (у файла без заголовка - "1", "2", ...)
+         */
+        static std::vector<std::string> readHeader(const std::string &path, const ReadOptions &options = {}) {
+            DelimitedParser parser(options.delimiter, {}, options.number_format);
+            parser.headerOnly(true);
+            bool decompression_failed = false;
+            parseFile(path, options.mode, parser, [](std::size_t, double) {}, decompression_failed);
+            return parser.header();
+        }
+
+        /**
+         * @brief readColumns
+         * Читает выбранные в options.columns столбцы CSV файла за один проход
+         */
+        static DelimitedData readColumns(const std::string &path, const ReadOptions &options = {}) {
+            S21_PROFILE_SCOPE("parse columns");
+            DelimitedParser parser(options.delimiter, options.columns, options.number_format);
+            applyErrorPolicy(parser, options);
+            std::vector<std::vector<double>> columns(std::max<std::size_t>(1, options.columns.size()));
+            DelimitedData data;
+            parseFile(path, options.mode, parser, [&columns](std::size_t slot, double value) { columns[slot].push_back(value); },
+                      data.decompression_failed);
+            S21_PROFILE_COUNT(columns.front().size()); // Строки выбранных столбцов
+
+            data.header = parser.header();
+            data.names = parser.columns();
+            columns.resize(data.names.size());
+            data.columns = std::move(columns);
+            data.number_format = parser.numberFormat();
+            data.stopped = parser.stopped();
+            data.skipped = parser.errors().count();
+            data.errors = parser.errors().errors();
+            return data;
+        }
+
+    private:
+        struct Chunk {
+            const char *begin, *end;
+            std::vector<double> statistic;
+            bool stopped;
+            std::size_t reallocations;
+            ParseErrorLog errors;
+        };
+
+        template <typename Parser>
+        static void applyErrorPolicy(Parser &parser, const ReadOptions &options) {
+            if (options.invalid_values == InvalidValues::kSkip)
+                parser.skipInvalid(options.max_reported_errors);
+        }
+
+        static void reportErrors(const ParseErrorLog &errors, ReadReport &report) {
+            report.skipped = errors.count();
+            report.errors = errors.errors();
+        }
+
+        /**
+         * Оценка количества значений в size байтах по средней длине значения (с разделителем) в sample\n
+         * Оценка немного завышается, чтобы неровный файл не приводил к перевыделению в конце чтения
+         */
+        static std::size_t estimateCount(const char *sample, std::size_t sample_size, std::size_t size) noexcept {
+            std::size_t tokens = 0;
+            bool in_token = false;
+            for (std::size_t current = 0; current != sample_size; ++current) {
+                bool space = NumberParser::isSpace(sample[current]);
+                tokens += !space and !in_token;
+                in_token = !space;
+            }
+            if (!tokens)
+                return 0;
+            double average_length = static_cast<double>(sample_size) / static_cast<double>(tokens);
+            return static_cast<std::size_t>(static_cast<double>(size) / average_length * 1.05) + 16;
+        }
+
+        /**
+         * Добавляет значение, считая перевыделения памяти вектора
+         */
+        static void append(std::vector<double> &statistic, double value, std::size_t &reallocations) {
+            if (statistic.size() == statistic.capacity())
+                ++reallocations;
+            statistic.push_back(value);
+        }
+
+        static std::vector<double> readMapped(const char *begin, const char *end, const ReadOptions &options, ReadReport &report) {
+            std::size_t size = static_cast<std::size_t>(end - begin);
+            std::size_t threads = options.threads_count ? options.threads_count : ThreadPool::defaultThreadsCount();
+            report.bytes = size;
+            report.estimated_values = estimateCount(begin, std::min(size, kSampleSize), size);
+            // Запись определяется один раз по началу файла: части ниже не должны определять ее каждая по-своему
+            report.number_format = options.number_format.value_or(NumberParser::detectFormat(begin, begin + std::min(size, NumberParser::kDetectSize)));
+            const NumberFormat format = report.number_format;
+            if (size < options.parallel_threshold or threads < 2) {
+                S21_PROFILE_SCOPE("parse");
+                std::vector<double> statistic;
+                statistic.reserve(report.estimated_values);
+                NumberParser parser(format);
+                applyErrorPolicy(parser, options);
+                std::size_t &reallocations = report.reallocations;
+                parser.parse(begin, end, true, [&statistic, &reallocations](double value) { append(statistic, value, reallocations); });
+                S21_PROFILE_COUNT(statistic.size());
+                report.stopped = parser.stopped();
+                reportErrors(parser.errors(), report);
+                return statistic;
+            }
+
+            S21_PROFILE_SCOPE("parse");
+            std::vector<Chunk> chunks;
+            const char *chunk_begin = begin;
+            for (std::size_t chunk = 1; chunk <= threads and chunk_begin != end; ++chunk) {
+                const char *chunk_end = chunk == threads ? end : begin + size / threads * chunk;
+                if (chunk_end < chunk_begin)
+                    chunk_end = chunk_begin;
+                while (chunk_end != end and !NumberParser::isSpace(*chunk_end))
+                    ++chunk_end;
+                chunks.push_back(Chunk{chunk_begin, chunk_end, {}, false, 0, ParseErrorLog{}});
+                chunk_begin = chunk_end;
+            }
+
+            auto &pool = ThreadPool::shared();
+            pool.parallelFor(chunks.size(), [&chunks, &report, &options, size, format](std::size_t index) {
+                auto &chunk = chunks[index];
+                std::size_t chunk_size = static_cast<std::size_t>(chunk.end - chunk.begin);
+                chunk.statistic.reserve(static_cast<std::size_t>(static_cast<double>(report.estimated_values) * chunk_size / size) + 16);
+                NumberParser parser(format);
+                applyErrorPolicy(parser, options);
+                parser.parse(chunk.begin, chunk.end, true, [&chunk](double value) { append(chunk.statistic, value, chunk.reallocations); });
+                chunk.stopped = parser.stopped();
+                if (options.invalid_values == InvalidValues::kSkip)
+                    chunk.errors = std::move(parser.errors());
+            });
+            for (const auto &chunk : chunks)
+                report.reallocations += chunk.reallocations;
+            if (options.invalid_values == InvalidValues::kSkip) {
+                ParseErrorLog errors = std::move(chunks.front().errors);
+                for (std::size_t index = 1; index != chunks.size(); ++index)
+                    errors.append(chunks[index].errors, chunks[index].begin);
+                reportErrors(errors, report);
+            }
+
+            std::vector<std::size_t> offsets(1, 0);
+            for (const auto &chunk : chunks) {
+                offsets.push_back(offsets.back() + chunk.statistic.size());
+                if (chunk.stopped) { // Все, что после некорректного значения, отбрасывается
+                    report.stopped = true;
+                    break;
+                }
+            }
+            S21_PROFILE_COUNT(offsets.back());
+            S21_PROFILE_SCOPE("merge");
+            S21_PROFILE_COUNT(offsets.back());
+            std::vector<double> statistic(offsets.back());
+            pool.parallelFor(offsets.size() - 1, [&](std::size_t index) {
+                std::copy(chunks[index].statistic.begin(), chunks[index].statistic.end(), statistic.begin() + offsets[index]);
+                std::vector<double>().swap(chunks[index].statistic);
+            });
+            return statistic;
+        }
+
+        /**
+         * Размер файла известен только для обычных файлов, у pipe память не резервируется заранее
+         */
+        static std::vector<double> readBuffered(const std::string &path, const ReadOptions &options, ReadReport &report) {
+            S21_PROFILE_SCOPE("parse");
+            std::vector<double> statistic;
+            std::size_t &reallocations = report.reallocations;
+            NumberParser parser(options.number_format);
+            applyErrorPolicy(parser, options);
+            parseBuffered(path, parser, [&statistic, &reallocations](double value) { append(statistic, value, reallocations); },
+                          report.decompression_failed, [&statistic, &report](std::ifstream &fin, const char *first_block, std::size_t first_size, Compression compression) {
+                report.compression = compression;
+                if (compression != Compression::kNone)
+                    return;
+                std::streamoff size = static_cast<std::streamoff>(first_size);
+                if (!fin.eof()) { // Файл длиннее первого блока
+                    auto position = fin.tellg();
+                    if (position < 0 or !fin.seekg(0, std::ios::end)) {
+                        fin.clear();
+                        return;
+                    }
+                    size = fin.tellg();
+                    fin.seekg(position);
+                }
+                if (size <= 0)
+                    return;
+                report.bytes = static_cast<std::size_t>(size);
+                report.estimated_values = estimateCount(first_block, std::min(first_size, kSampleSize), report.bytes);
+                statistic.reserve(report.estimated_values);
+            });
+            S21_PROFILE_COUNT(statistic.size());
+            report.number_format = parser.format();
+            report.stopped = parser.stopped();
+            reportErrors(parser.errors(), report);
+            return statistic;
+        }
+
+        /**
+         * on_first_block(fin, block, size, compression) вызывается после чтения первого блока, до его разбора\n
+         * Сжатый файл передается parseCompressed вместе с уже прочитанным первым блоком, поэтому работает и для pipe,\n
+         * decompression_failed - результат parseCompressed
+         */
+        template <typename Parser, typename Sink, typename FirstBlock>
+        static bool parseBuffered(const std::string &path, Parser &parser, Sink &&sink, bool &decompression_failed,
+                                  FirstBlock &&on_first_block) {
+            std::ifstream fin(path, std::ios::binary);
             if (!fin.is_open())
-                return {};
-            std::vector<double> statistic{std::istream_iterator<double>(fin), std::istream_iterator<double>()};
+                return false;
+            std::vector<char> buffer(kBlockSize);
+            std::size_t carry = 0;
+            for (bool first_block = true; true; first_block = false) {
+                if (buffer.size() < carry + kBlockSize) // Значение длиннее блока
+                    buffer.resize(carry + kBlockSize);
+                fin.read(buffer.data() + carry, static_cast<std::streamsize>(kBlockSize));
+                std::size_t read_size = static_cast<std::size_t>(fin.gcount());
+                bool last_block = read_size < kBlockSize;
+                if (first_block) {
+                    Compression compression = detectCompression(buffer.data(), read_size);
+                    on_first_block(fin, static_cast<const char *>(buffer.data()), read_size, compression);
+                    if (compression != Compression::kNone) {
+                        const char *prefix = buffer.data();
+                        std::size_t prefix_size = read_size;
+                        decompression_failed = !parseCompressed(compression, [&fin, prefix, prefix_size](char *data, std::size_t capacity) mutable {
+                            if (prefix_size) {
+                                std::size_t size = std::min(prefix_size, capacity);
+                                std::memcpy(data, prefix, size);
+                                prefix += size, prefix_size -= size;
+                                return size;
+                            }
+                            fin.read(data, static_cast<std::streamsize>(capacity));
+                            return static_cast<std::size_t>(fin.gcount());
+                        }, parser, sink);
+                        return true;
+                    }
+                }
+
+                const char *begin = buffer.data(), *end = begin + carry + read_size;
+                const char *stop = parser.parse(begin, end, last_block, sink);
+                if (last_block or parser.stopped())
+                    break;
+                carry = static_cast<std::size_t>(end - stop);
+                std::memmove(buffer.data(), stop, carry);
+            }
             fin.close();
-            return statistic;
+            return true;
+        }
+
+        static bool endsWith(const std::string &text, const char *suffix) {
+            std::size_t size = std::strlen(suffix);
+            if (text.size() < size)
+                return false;
+            return std::equal(suffix, suffix + size, text.end() - static_cast<std::ptrdiff_t>(size), [](char lhs, char rhs) {
+                return lhs == std::tolower(static_cast<unsigned char>(rhs));
+            });
+        }
+
+        /**
+         * Разбирает файл целиком одним парсером: отображение в память, сжатый поток или чтение блоками\n
+         * decompression_failed - сжатый файл распакован не до конца
+         * @return
+         * false, если файл не открылся
+         */
+        template <typename Parser, typename Sink>
+        static bool parseFile(const std::string &path, ReadMode mode, Parser &parser, Sink &&sink, bool &decompression_failed) {
+            if (mode != ReadMode::kBuffered) {
+                MappedFile file(path);
+                if (file.isOpen()) {
+                    Compression compression = detectCompression(file.data(), file.size());
+                    if (compression != Compression::kNone)
+                        decompression_failed = !parseCompressed(compression, memoryInput(file.begin(), file.end()), parser, sink);
+                    else
+                        parser.parse(file.begin(), file.end(), true, sink);
+                    return true;
+                }
+                if (mode == ReadMode::kMapped)
+                    return false;
+            }
+            return parseBuffered(path, parser, sink, decompression_failed, [](std::ifstream &, const char *, std::size_t, Compression) {});
+        }
+
+        static Decompressor::input_type memoryInput(const char *begin, const char *end) {
+            return [begin, end](char *data, std::size_t capacity) mutable {
+                std::size_t size = std::min(capacity, static_cast<std::size_t>(end - begin));
+                std::memcpy(data, begin, size);
+                begin += size;
+                return size;
+            };
+        }
+
+        /**
+         * Распакованные блоки разбираются по мере поступления, незаконченное в конце блока значение\n
+         * переносится в начало следующего, как и при чтении файла блоками\n
+         * Если вход оборвался или поврежден, значение, на котором оборвалась распаковка, отбрасывается
+         * @return
+         * false, если формат не поддерживается сборкой или файл не распакован до конца
+         */
+        template <typename Parser, typename Sink>
+        static bool parseCompressed(Compression compression, Decompressor::input_type input, Parser &parser, Sink &&sink) {
+            if (!compressionSupported(compression))
+                return false;
+            Decompressor decompressor(compression, kBlockSize);
+            decompressor.start(std::move(input));
+            std::vector<char> buffer, block;
+            std::size_t carry = 0;
+            while (decompressor.next(block)) {
+                buffer.resize(carry + block.size());
+                std::memcpy(buffer.data() + carry, block.data(), block.size());
+                const char *begin = buffer.data(), *end = begin + buffer.size();
+                const char *stop = parser.parse(begin, end, false, sink);
+                if (parser.stopped())
+                    return true;
+                carry = static_cast<std::size_t>(end - stop);
+                std::memmove(buffer.data(), stop, carry);
+            }
+            if (decompressor.failed())
+                return false;
+            parser.parse(buffer.data(), buffer.data() + carry, true, sink);
+            return true;
         }
     };
 }
@@ -0,0 +1,298 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_MODEL_DATAREADER_DECOMPRESSOR_H_
+#define STATISTIC_ANALYZER_MODEL_DATAREADER_DECOMPRESSOR_H_
+
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <condition_variable>
+
+#if defined(S21_WITH_ZLIB)
+#  include <zlib.h>
+#endif
+#if defined(S21_WITH_ZSTD)
+#  include <zstd.h>
+#endif
+
+namespace s21 {
+    enum class Compression { kNone, kGzip, kZstd };
+
+    /**
+     * @brief detectCompression
+     * Определяет формат сжатия по первым байтам файла (gzip: 1F 8B, zstd: 28 B5 2F FD)
+     */
+    inline Compression detectCompression(const char *data, std::size_t size) noexcept {
+        const auto *bytes = reinterpret_cast<const unsigned char *>(data);
+        if (size >= 2 and bytes[0] == 0x1F and bytes[1] == 0x8B)
+            return Compression::kGzip;
+        if (size >= 4 and bytes[0] == 0x28 and bytes[1] == 0xB5 and bytes[2] == 0x2F and bytes[3] == 0xFD)
+            return Compression::kZstd;
+        return Compression::kNone;
+    }
+
+    /**
+     * @brief compressionSupported
+     * Поддержка форматов подключается при сборке: CONFIG += s21_zlib / s21_zstd (S21_WITH_ZLIB / S21_WITH_ZSTD)
+     */
+    inline bool compressionSupported(Compression compression) noexcept {
+        switch (compression) {
+            case Compression::kNone: return true;
+#if defined(S21_WITH_ZLIB)
+            case Compression::kGzip: return true;
+#endif
+#if defined(S21_WITH_ZSTD)
+            case Compression::kZstd: return true;
+#endif
+            default: return false;
+        }
+    }
+
+    /**
+     * @class BlockQueue\n
+     * Ограниченная очередь блоков между потоком распаковки и потоком разбора:\n
+     * push() ждет, пока в очереди есть место, pop() - пока появится блок\n
+     * close() завершает обмен с любой стороны - push() после него возвращает false,\n
+     * pop() возвращает false, когда блоки закончились\n\n
+     * Non-copyable, non-moveable, final class
+     */
+    class BlockQueue final {
+    public:
+        using block_type = std::vector<char>;
+
+    public:
+        explicit BlockQueue(std::size_t capacity) : capacity_(capacity ? capacity : 1) {}
+
+        BlockQueue(const BlockQueue &) = delete;
+        BlockQueue &operator=(const BlockQueue &) = delete;
+
+    public:
+        bool push(block_type &&block) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_full_.wait(lock, [this] { return closed_ or blocks_.size() < capacity_; });
+            if (closed_)
+                return false;
+            blocks_.push_back(std::move(block));
+            not_empty_.notify_one();
+            return true;
+        }
+
+        bool pop(block_type &block) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_empty_.wait(lock, [this] { return closed_ or !blocks_.empty(); });
+            if (blocks_.empty())
+                return false;
+            block = std::move(blocks_.front());
+            blocks_.pop_front();
+            not_full_.notify_one();
+            return true;
+        }
+
+        void close() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+            not_empty_.notify_all();
+            not_full_.notify_all();
+        }
+
+    private:
+        std::size_t capacity_;
+        std::deque<block_type> blocks_;
+        std::mutex mutex_;
+        std::condition_variable not_empty_, not_full_;
+        bool closed_ = false;
+    };
+
+    /**
+     * @class Decompressor\n
+     * Распаковывает поток gzip или zstd на отдельном потоке в BlockQueue блоками по block_size байт\n
+     * Сжатые данные берутся из input(buffer, capacity) -> количество прочитанных байт (0 - конец входа)\n
+     * Несколько подряд записанных gzip членов / zstd кадров распаковываются как один поток\n\n
+     * start(input) - запускает поток распаковки, next(block) - следующий распакованный блок,\n
+     * false - данные закончились; failed() - вход поврежден или формат не поддерживается сборкой\n
+     * Деструктор останавливает распаковку, даже если не все блоки были прочитаны\n\n
+     * Non-copyable, non-moveable, final class
+     */
+    class Decompressor final {
+    public:
+        using input_type = std::function<std::size_t(char *, std::size_t)>;
+
+    public:
+        Decompressor(Compression compression, std::size_t block_size, std::size_t queue_capacity = 4)
+            : compression_(compression), block_size_(block_size), queue_(queue_capacity) {}
+
+        Decompressor(const Decompressor &) = delete;
+        Decompressor &operator=(const Decompressor &) = delete;
+
+        ~Decompressor() {
+            queue_.close();
+            if (worker_.joinable())
+                worker_.join();
+        }
+
+    public:
+        void start(input_type input) {
+            worker_ = std::thread([this, input = std::move(input)] {
+                bool succeeded = false;
+                switch (compression_) {
+#if defined(S21_WITH_ZLIB)
+                    case Compression::kGzip: succeeded = inflateGzip(input); break;
+#endif
+#if defined(S21_WITH_ZSTD)
+                    case Compression::kZstd: succeeded = decompressZstd(input); break;
+#endif
+                    default: break;
+                }
+                failed_ = !succeeded;
+                queue_.close();
+            });
+        }
+
+        /**
+         * Предыдущее содержимое block возвращается распаковщику для повторного использования
+         */
+        bool next(BlockQueue::block_type &block) {
+            if (block.capacity() >= block_size_) {
+                std::lock_guard<std::mutex> lock(spare_mutex_);
+                spare_.push_back(std::move(block));
+            }
+            return queue_.pop(block);
+        }
+
+        /**
+         * Результат известен только после того, как next() вернул false
+         */
+        bool failed() const noexcept { return failed_; }
+
+    private:
+        Compression compression_;
+        std::size_t block_size_;
+        BlockQueue queue_;
+        std::thread worker_;
+        bool failed_ = false;
+        std::vector<BlockQueue::block_type> spare_; // Прочитанные блоки, память которых используется снова
+        std::mutex spare_mutex_;
+
+        static constexpr std::size_t kInputSize = 1 << 18;
+
+    private:
+        BlockQueue::block_type takeBlock() {
+            BlockQueue::block_type block;
+            {
+                std::lock_guard<std::mutex> lock(spare_mutex_);
+                if (!spare_.empty()) {
+                    block = std::move(spare_.back());
+                    spare_.pop_back();
+                }
+            }
+            block.resize(block_size_);
+            return block;
+        }
+
+#if defined(S21_WITH_ZLIB)
+        bool inflateGzip(const input_type &input) {
+            z_stream stream {};
+            if (inflateInit2(&stream, 15 + 32) != Z_OK) // 15 + 32: gzip или zlib заголовок определяется автоматически
+                return false;
+            std::vector<char> compressed(kInputSize);
+            BlockQueue::block_type block = takeBlock();
+            stream.next_out = reinterpret_cast<Bytef *>(block.data());
+            stream.avail_out = static_cast<uInt>(block.size());
+            bool succeeded = false, stream_end = false, input_end = false;
+            while (true) {
+                if (!stream.avail_in and !input_end) {
+                    std::size_t size = input(compressed.data(), compressed.size());
+                    input_end = !size;
+                    stream.next_in = reinterpret_cast<Bytef *>(compressed.data());
+                    stream.avail_in = static_cast<uInt>(size);
+                }
+                if (stream_end) {
+                    if (!stream.avail_in and input_end) {
+                        succeeded = true;
+                        break;
+                    }
+                    if (!stream.avail_in)
+                        continue;
+                    inflateReset(&stream); // Следующий gzip член
+                    stream_end = false;
+                }
+                uInt available = stream.avail_out;
+                int status = inflate(&stream, Z_NO_FLUSH);
+                if (status == Z_STREAM_END)
+                    stream_end = true;
+                else if (status != Z_OK and status != Z_BUF_ERROR)
+                    break;
+                if (!stream.avail_out) {
+                    if (!queue_.push(std::move(block)))
+                        break;
+                    block = takeBlock();
+                    stream.next_out = reinterpret_cast<Bytef *>(block.data());
+                    stream.avail_out = static_cast<uInt>(block.size());
+                } else if (input_end and !stream_end and stream.avail_out == available) {
+                    break; // Файл обрезан
+                }
+            }
+            block.resize(block.size() - stream.avail_out);
+            if (!block.empty())
+                queue_.push(std::move(block));
+            inflateEnd(&stream);
+            return succeeded;
+        }
+#endif
+
+#if defined(S21_WITH_ZSTD)
+        bool decompressZstd(const input_type &input) {
+            ZSTD_DStream *stream = ZSTD_createDStream();
+            if (!stream)
+                return false;
+            std::vector<char> compressed(ZSTD_DStreamInSize());
+            BlockQueue::block_type block = takeBlock();
+            ZSTD_inBuffer in {compressed.data(), 0, 0};
+            ZSTD_outBuffer out {block.data(), block.size(), 0};
+            std::size_t status = 0;
+            bool input_end = false;
+            while (true) {
+                if (in.pos == in.size and !input_end) {
+                    in = ZSTD_inBuffer{compressed.data(), input(compressed.data(), compressed.size()), 0};
+                    input_end = !in.size; // Дальше только выгружаются данные из буфера декодера
+                }
+                if (input_end and !status) // Последний кадр декодирован и выгружен полностью
+                    break;
+                std::size_t produced = out.pos;
+                status = ZSTD_decompressStream(stream, &out, &in);
+                if (ZSTD_isError(status))
+                    break;
+                if (out.pos == out.size) {
+                    if (!queue_.push(std::move(block)))
+                        break;
+                    block = takeBlock();
+                    out = ZSTD_outBuffer{block.data(), block.size(), 0};
+                } else if (input_end and out.pos == produced) {
+                    break;
+                }
+            }
+            block.resize(out.pos);
+            if (!block.empty())
+                queue_.push(std::move(block));
+            bool succeeded = input_end and !ZSTD_isError(status) and !status; // 0 - последний кадр завершен
+            ZSTD_freeDStream(stream);
+            return succeeded;
+        }
+#endif
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_MODEL_DATAREADER_DECOMPRESSOR_H_
@@ -0,0 +1,408 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_MODEL_DATAREADER_DELIMITED_PARSER_H_
+#define STATISTIC_ANALYZER_MODEL_DATAREADER_DELIMITED_PARSER_H_
+
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <cstring>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+#include "number_parser.h"
+#include "parse_errors.h"
+
+namespace s21 {
+    /**
+     * @class DelimitedParser class разбирает CSV / TSV файлы с заголовком, выбирая из строк нужные числовые столбцы\n\n
+     * @methods
+     * a) parse(begin, end, last_block, sink) -> разбирает блок [begin, end) построчно, значения выбранных столбцов\n
+     *      передаются в sink(slot, double), slot - номер столбца в порядке columns(), возвращает начало\n
+     *      незаконченной строки в конце блока (как и NumberParser)\n
+     * b) stopped() -> встретилось нечисловое значение в выбранном столбце или выбранного столбца нет в заголовке\n
+     *      После skipInvalid(max_errors) нечисловые значения пропускаются как пустые ячейки и учитываются в errors()\n
+     * c) header() / columns() -> имена всех столбцов / выбранных столбцов, известны после разбора первой строки\n\n
+     * @implementation
+     * Разделитель определяется по первой строке, если не задан явно: '\\t' или ';', если они в ней есть, иначе ','\n
+     * (';' предпочитается ',', так как запятая бывает десятичным разделителем: 12,5;13,1)\n
+     * Запись чисел (NumberFormat) определяется по первому блоку файла, если не задана явно\n
+     * Первая строка считается заголовком, если в ней есть нечисловое поле, иначе столбцы называются "1", "2", ...\n
+     * Если столбцы не выбраны, берется первый столбец, значение которого в первой строке данных - число\n
+     * Поля между выбранными столбцами не разбираются: разделители ищутся SSE2 сравнением блоками по 64 байта,\n
+     * блок без перевода строки и кавычек пропускается целиком, если в нем меньше разделителей, чем нужно пропустить,\n
+     * остаток строки после последнего выбранного столбца пропускается тем же поиском\n
+     * Поля в кавычках (в том числе с разделителями и "" внутри) поддерживаются, пустые ячейки пропускаются
+     */
+    class DelimitedParser final {
+    public:
+        DelimitedParser() = default;
+        DelimitedParser(char delimiter, std::vector<std::string> columns, std::optional<NumberFormat> number_format = std::nullopt)
+            : delimiter_(delimiter), requested_(std::move(columns)),
+              number_format_(number_format.value_or(NumberFormat{})), detect_format_(!number_format) {}
+
+    public:
+        template <typename Sink>
+        const char *parse(const char *begin, const char *end, bool last_block, Sink &&sink) {
+            if (!skip_)
+                return parseBlock(begin, end, last_block, sink);
+            errors_.beginBlock(begin);
+            const char *stop = parseBlock(begin, end, last_block, sink);
+            if (!last_block and !errors_.full())
+                errors_.endBlock(stop);
+            return stop;
+        }
+
+        bool stopped() const noexcept { return stopped_; }
+
+        void skipInvalid(std::size_t max_errors) {
+            skip_ = true;
+            errors_ = ParseErrorLog(max_errors);
+        }
+
+        const ParseErrorLog &errors() const noexcept { return errors_; }
+
+        /**
+         * Разбор заканчивается сразу после заголовка, нужно только для получения списка столбцов
+         */
+        void headerOnly(bool header_only) noexcept { header_only_ = header_only; }
+
+        char delimiter() const noexcept { return delimiter_; }
+        const NumberFormat &numberFormat() const noexcept { return number_format_; }
+        const std::vector<std::string> &header() const noexcept { return header_; }
+        std::vector<std::string> columns() const {
+            std::vector<std::string> columns;
+            for (auto index : selected_)
+                columns.push_back(index < header_.size() ? header_[index] : std::string());
+            return columns;
+        }
+
+    private:
+        char delimiter_ = '\0';
+        std::vector<std::string> requested_;
+        NumberFormat number_format_;
+        bool detect_format_ = false;
+        std::vector<std::string> header_;
+        std::vector<std::size_t> selected_;           // Индексы выбранных столбцов в порядке запроса
+        std::vector<std::pair<std::size_t, std::size_t>> order_; // {индекс столбца, slot} по возрастанию индекса
+        std::vector<std::pair<std::size_t, double>> row_;        // Значения текущей строки до ее завершения
+        std::vector<std::pair<const char *, const char *>> row_errors_; // Нечисловые ячейки текущей строки
+        bool header_parsed_ = false, header_only_ = false, stopped_ = false, skip_ = false;
+        ParseErrorLog errors_;
+
+    private:
+        template <typename Sink>
+        const char *parseBlock(const char *begin, const char *end, bool last_block, Sink &&sink) {
+            const char *current = begin;
+            if (!header_parsed_) {
+                const char *line_end = static_cast<const char *>(std::memchr(current, '\n', static_cast<std::size_t>(end - current)));
+                if (!line_end and !last_block)
+                    return current;
+                if (!line_end)
+                    line_end = end;
+                if (parseHeader(current, line_end, end))
+                    current = line_end != end ? line_end + 1 : end;
+                if (stopped_ or header_only_) {
+                    stopped_ = true;
+                    return current;
+                }
+            }
+
+            while (current != end and !stopped_) {
+                const char *line_end = parseLine(current, end, sink);
+                if (!line_end) { // Строка продолжается в следующем блоке
+                    if (!last_block)
+                        return current;
+                    line_end = parseLine(current, end, sink, true);
+                }
+                current = line_end != end ? line_end + 1 : end;
+            }
+            return current;
+        }
+
+        /**
+         * @return
+         * true, если первая строка - заголовок и данные начинаются со следующей строки
+         */
+        bool parseHeader(const char *begin, const char *end, const char *block_end) {
+            header_parsed_ = true;
+            if (!delimiter_)
+                delimiter_ = detectDelimiter(begin, end);
+            if (detect_format_) {
+                std::size_t size = std::min<std::size_t>(static_cast<std::size_t>(block_end - begin), NumberParser::kDetectSize);
+                number_format_ = NumberParser::detectFormat(begin, begin + size, delimiter_);
+                detect_format_ = false;
+            }
+
+            bool has_header = false;
+            std::vector<std::string> fields;
+            for (const char *current = begin; ; ++current) {
+                const char *field_end = findDelimiter(current, end, 1);
+                auto [first, last] = trim(current, field_end);
+                std::string field = unquote(first, last);
+                double value;
+                if (!field.empty() and !NumberParser::parseToken(field.data(), field.data() + field.size(), value, number_format_))
+                    has_header = true;
+                fields.push_back(std::move(field));
+                current = field_end;
+                if (current == end or *current != delimiter_)
+                    break;
+            }
+            if (has_header) {
+                header_ = std::move(fields);
+            } else {
+                for (std::size_t column = 1; column <= fields.size(); ++column)
+                    header_.push_back(std::to_string(column));
+            }
+
+            for (const auto &name : requested_) {
+                auto found = std::find(header_.begin(), header_.end(), name);
+                if (found == header_.end()) {
+                    stopped_ = true; // Выбранного столбца нет в файле
+                    return has_header;
+                }
+                select(static_cast<std::size_t>(found - header_.begin()));
+            }
+            if (requested_.empty() and !has_header)
+                selectFirstNumeric(fields);
+            return has_header;
+        }
+
+        void select(std::size_t index) {
+            order_.emplace_back(index, selected_.size());
+            selected_.push_back(index);
+            std::sort(order_.begin(), order_.end());
+        }
+
+        void selectFirstNumeric(const std::vector<std::string> &fields) {
+            for (std::size_t index = 0; index != fields.size(); ++index) {
+                double value;
+                if (NumberParser::parseToken(fields[index].data(), fields[index].data() + fields[index].size(), value, number_format_)) {
+                    select(index);
+                    return;
+                }
+            }
+        }
+
+        /**
+         * Разбирает строку, начинающуюся с begin\n
+         * @return
+         * Конец строки ('\\n' или end при last_block), nullptr - строка не закончилась до end
+         */
+        template <typename Sink>
+        const char *parseLine(const char *begin, const char *end, Sink &&sink, bool last_block = false) {
+            if (selected_.empty()) {
+                std::vector<std::string> fields;
+                const char *line_end = splitLine(begin, end, fields);
+                if (line_end == end and !last_block)
+                    return nullptr;
+                if (!(fields.size() == 1 and fields.front().empty())) { // Пустые строки пропускаются
+                    selectFirstNumeric(fields);
+                    if (selected_.empty())
+                        stopped_ = true;
+                }
+                if (stopped_)
+                    return line_end;
+            }
+
+            row_.clear();
+            row_errors_.clear();
+            const char *current = begin;
+            std::size_t column = 0;
+            bool line_ended = false;
+            for (const auto &[index, slot] : order_) {
+                if (index != column) {
+                    current = findDelimiter(current, end, index - column);
+                    if (current == end or *current != delimiter_) {
+                        line_ended = true;
+                        break;
+                    }
+                    ++current;
+                    column = index;
+                }
+                const char *field_end = findDelimiter(current, end, 1);
+                if (field_end == end and !last_block)
+                    return nullptr;
+                auto [first, last] = trim(current, field_end);
+                const char *field_first = first, *field_last = last;
+                std::string quoted;
+                if (first != last and *first == '"') {
+                    quoted = unquote(first, last);
+                    std::tie(first, last) = trim(quoted.data(), quoted.data() + quoted.size());
+                }
+                if (first != last) {
+                    double value;
+                    if (NumberParser::parseToken(first, last, value, number_format_)) {
+                        row_.emplace_back(slot, value);
+                    } else if (skip_) {
+                        row_errors_.emplace_back(field_first, field_last);
+                    } else {
+                        stopped_ = true;
+                        return field_end;
+                    }
+                }
+                current = field_end;
+                if (current == end or *current != delimiter_) {
+                    line_ended = true;
+                    break;
+                }
+                ++current;
+                ++column;
+            }
+
+            const char *line_end = current;
+            if (!line_ended) // Остаток строки пропускается целиком, с учетом переводов строк в кавычках
+                line_end = findDelimiter(current, end, static_cast<std::size_t>(-1));
+            if (line_end == end and !last_block)
+                return nullptr;
+            for (const auto &[token, token_end] : row_errors_) // Строка закончена: ошибки не будут посчитаны повторно
+                errors_.report(token, token_end);
+            for (const auto &[slot, value] : row_)
+                sink(slot, value);
+            return line_end;
+        }
+
+        const char *splitLine(const char *begin, const char *end, std::vector<std::string> &fields) const {
+            for (const char *current = begin; ; ++current) {
+                const char *field_end = findDelimiter(current, end, 1);
+                auto [first, last] = trim(current, field_end);
+                fields.push_back(unquote(first, last));
+                current = field_end;
+                if (current == end or *current != delimiter_)
+                    return current;
+            }
+        }
+
+        /**
+         * @return
+         * Позиция count-го разделителя строки, начиная с current, либо конца строки ('\\n' или end)\n
+         * Разделители и переводы строк внутри кавычек пропускаются
+         */
+        const char *findDelimiter(const char *current, const char *end, std::size_t count) const noexcept {
+#if defined(__SSE2__)
+            while (end - current >= 64) {
+                std::uint64_t delimiter_mask, stop_mask;
+                scanBlock(current, delimiter_mask, stop_mask);
+                std::size_t delimiters_count = static_cast<std::size_t>(__builtin_popcountll(delimiter_mask));
+                if (!stop_mask and delimiters_count < count) {
+                    count -= delimiters_count;
+                    current += 64;
+                    continue;
+                }
+                std::uint64_t mask = delimiter_mask | stop_mask;
+                while (mask) {
+                    const char *position = current + __builtin_ctzll(mask);
+                    if (*position != delimiter_)
+                        break; // '\n' или кавычка - дальше разбирается посимвольно
+                    if (!--count)
+                        return position;
+                    mask &= mask - 1;
+                }
+                if (!mask) {
+                    current += 64;
+                    continue;
+                }
+                current += __builtin_ctzll(mask);
+                if (*current == '\n')
+                    return current;
+                current = skipQuoted(current, end);
+            }
+#endif
+            for (; current != end; ++current) {
+                if (*current == delimiter_) {
+                    if (!--count)
+                        return current;
+                } else if (*current == '\n') {
+                    return current;
+                } else if (*current == '"') {
+                    current = skipQuoted(current, end) - 1; // Цикл продолжается с символа за кавычкой
+                }
+            }
+            return end;
+        }
+
+#if defined(__SSE2__)
+        /**
+         * Битовые маски разделителей и символов '\n', '"' в 64 байтах, начиная с data (бит i - байт data[i])
+         */
+        void scanBlock(const char *data, std::uint64_t &delimiter_mask, std::uint64_t &stop_mask) const noexcept {
+            const __m128i delimiters = _mm_set1_epi8(delimiter_), newlines = _mm_set1_epi8('\n'), quotes = _mm_set1_epi8('"');
+            delimiter_mask = stop_mask = 0;
+            for (int part = 0; part != 4; ++part) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * part));
+                auto delimiter_bits = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, delimiters)));
+                auto stop_bits = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, newlines),
+                                                                                           _mm_cmpeq_epi8(chunk, quotes))));
+                delimiter_mask |= static_cast<std::uint64_t>(delimiter_bits) << (16 * part);
+                stop_mask |= static_cast<std::uint64_t>(stop_bits) << (16 * part);
+            }
+        }
+#endif
+
+        /**
+         * @return
+         * Позиция за закрывающей кавычкой ("" внутри кавычек - экранированная кавычка)
+         */
+        static const char *skipQuoted(const char *quote, const char *end) noexcept {
+            for (const char *current = quote + 1; current != end; ++current) {
+                if (*current != '"')
+                    continue;
+                if (current + 1 != end and current[1] == '"')
+                    ++current;
+                else
+                    return current + 1;
+            }
+            return end;
+        }
+
+        static std::pair<const char *, const char *> trim(const char *begin, const char *end) noexcept {
+            while (begin != end and NumberParser::isSpace(*begin))
+                ++begin;
+            while (end != begin and NumberParser::isSpace(end[-1]))
+                --end;
+            return {begin, end};
+        }
+
+        static std::string unquote(const char *begin, const char *end) {
+            if (end - begin < 2 or *begin != '"' or end[-1] != '"')
+                return std::string(begin, end);
+            std::string field;
+            for (const char *current = begin + 1; current != end - 1; ++current) {
+                field.push_back(*current);
+                if (*current == '"' and current + 1 != end - 1 and current[1] == '"')
+                    ++current;
+            }
+            return field;
+        }
+
+        static char detectDelimiter(const char *begin, const char *end) noexcept {
+            std::size_t semicolons = 0, tabs = 0;
+            for (const char *current = begin; current != end; ++current) {
+                if (*current == '"')
+                    current = skipQuoted(current, end) - 1;
+                else
+                    semicolons += *current == ';', tabs += *current == '\t';
+            }
+            if (tabs and tabs >= semicolons)
+                return '\t';
+            return semicolons ? ';' : ',';
+        }
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_MODEL_DATAREADER_DELIMITED_PARSER_H_
@@ -0,0 +1,160 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_MODEL_DATAREADER_FOLLOW_READER_H_
+#define STATISTIC_ANALYZER_MODEL_DATAREADER_FOLLOW_READER_H_
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include "data_reader.h"
+
+namespace s21 {
+    /**
+     * @class FollowReader\n
+     * Читает файл, который дописывается во время работы (режим tail -f):\n
+     * каждый poll() разбирает только байты, добавленные с прошлого вызова, первый вызов - весь файл\n\n
+     * Парсер (NumberParser или DelimitedParser для CSV) живет между вызовами, поэтому запись чисел,\n
+     * заголовок CSV, номера строк пропущенных значений и незаконченное значение в конце файла\n
+     * (в том числе записанное частично: "1.5e" + "+10") переносятся в следующий poll();\n
+     * значение в конце файла учитывается, когда после него появится разделитель или перевод строки\n\n
+     * Если файл стал короче (перезаписан заново), разбор начинается с начала и poll() возвращает false\n
+     * Сжатые файлы не дописываются по частям и не поддерживаются: failed() == true\n\n
+     * Non-copyable, moveable, final class
+     */
+    class FollowReader final {
+    public:
+        static constexpr std::size_t kBlockSize = NormalDistributionStatisticReader::kBlockSize;
+
+    public:
+        explicit FollowReader(std::string path, const ReadOptions &options = {})
+            : path_(std::move(path)), options_(options),
+              delimited_(NormalDistributionStatisticReader::isDelimited(path_, options_)) {
+            restart();
+        }
+
+        FollowReader(const FollowReader &) = delete;
+        FollowReader &operator=(const FollowReader &) = delete;
+        FollowReader(FollowReader &&) = default;
+        FollowReader &operator=(FollowReader &&) = default;
+
+    public:
+        /**
+         * @brief poll
+         * Добавляет в values значения, дописанные в файл с прошлого вызова
+         * @return
+         * false, если файл был перезаписан и values содержит значения нового файла с самого начала
+         */
+        bool poll(std::vector<double> &values) {
+            std::ifstream fin(path_, std::ios::binary | std::ios::ate);
+            if (!fin.is_open() or failed_) // Файл может быть недоступен, пока его пересоздает записывающая программа
+                return true;
+            std::streamoff size = fin.tellg();
+            if (size < 0)
+                return true;
+            bool continued = true;
+            if (static_cast<std::uint64_t>(size) < offset_) {
+                restart();
+                continued = false;
+            }
+            if (static_cast<std::uint64_t>(size) == offset_ or stopped())
+                return continued;
+
+            S21_PROFILE_SCOPE("read appended");
+            [[maybe_unused]] std::size_t previous_size = values.size();
+            fin.seekg(static_cast<std::streamoff>(offset_));
+            while (true) {
+                buffer_.resize(carry_ + kBlockSize);
+                fin.read(buffer_.data() + carry_, static_cast<std::streamsize>(kBlockSize));
+                std::size_t read_size = static_cast<std::size_t>(fin.gcount());
+                if (!read_size)
+                    break;
+                if (!offset_ and detectCompression(buffer_.data(), read_size) != Compression::kNone) {
+                    failed_ = true;
+                    break;
+                }
+                offset_ += read_size;
+                const char *begin = buffer_.data(), *end = begin + carry_ + read_size;
+                const char *stop = parse(begin, end, values);
+                carry_ = static_cast<std::size_t>(end - stop);
+                std::memmove(buffer_.data(), stop, carry_);
+                if (stopped())
+                    break;
+            }
+            S21_PROFILE_COUNT(values.size() - previous_size);
+            return continued;
+        }
+
+        /**
+         * Сведения о всем прочитанном с начала файла (bytes - прочитано байт, values - передано значений)
+         */
+        ReadReport report() const {
+            ReadReport report;
+            report.bytes = static_cast<std::size_t>(offset_);
+            report.values = values_;
+            report.number_format = delimited_ ? delimited_parser_.numberFormat() : number_parser_.format();
+            report.stopped = stopped();
+            const ParseErrorLog &errors = delimited_ ? delimited_parser_.errors() : number_parser_.errors();
+            report.skipped = errors.count();
+            report.errors = errors.errors();
+            return report;
+        }
+
+        const std::string &path() const noexcept { return path_; }
+        bool failed() const noexcept { return failed_; }
+        bool stopped() const noexcept { return delimited_ ? delimited_parser_.stopped() : number_parser_.stopped(); }
+
+    private:
+        std::string path_;
+        ReadOptions options_;
+        bool delimited_;
+        NumberParser number_parser_;
+        DelimitedParser delimited_parser_;
+        std::vector<char> buffer_;
+        std::size_t carry_ = 0;      // Незаконченное значение (строка CSV) в начале buffer_
+        std::uint64_t offset_ = 0;   // Прочитано байт файла
+        std::size_t values_ = 0;
+        bool failed_ = false;
+
+    private:
+        void restart() {
+            number_parser_ = NumberParser(options_.number_format);
+            delimited_parser_ = DelimitedParser(options_.delimiter, options_.columns, options_.number_format);
+            if (options_.invalid_values == InvalidValues::kSkip) {
+                number_parser_.skipInvalid(options_.max_reported_errors);
+                delimited_parser_.skipInvalid(options_.max_reported_errors);
+            }
+            carry_ = 0;
+            offset_ = 0;
+            values_ = 0;
+        }
+
+        const char *parse(const char *begin, const char *end, std::vector<double> &values) {
+            std::size_t size = values.size();
+            const char *stop;
+            if (delimited_) {
+                stop = delimited_parser_.parse(begin, end, false, [&values](std::size_t slot, double value) {
+                    if (!slot)
+                        values.push_back(value);
+                });
+            } else {
+                stop = number_parser_.parse(begin, end, false, [&values](double value) { values.push_back(value); });
+            }
+            values_ += values.size() - size;
+            return stop;
+        }
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_MODEL_DATAREADER_FOLLOW_READER_H_
@@ -0,0 +1,132 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_MODEL_DATAREADER_MAPPED_FILE_H_
+#define STATISTIC_ANALYZER_MODEL_DATAREADER_MAPPED_FILE_H_
+
+#include <string>
+#include <cstddef>
+#include <utility>
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
+
+namespace s21 {
+    /**
+     * @class MappedFile\n
+     * Отображает обычный файл в память только для чтения (mmap / MapViewOfFile)\n
+     * и сообщает ядру, что файл будет читаться последовательно\n\n
+     * open(path) - возвращает false, если файл нельзя отобразить: он не открылся,\n
+     * пустой или не является обычным файлом (pipe, fifo, устройство) - тогда его нужно читать потоком\n\n
+     * Non-copyable, moveable, final class
+     */
+    class MappedFile final {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::string &path) { open(path); }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&other) noexcept
+            : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+        MappedFile &operator=(MappedFile &&other) noexcept {
+            if (this != &other) {
+                close();
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+            }
+            return *this;
+        }
+
+        ~MappedFile() { close(); }
+
+    public:
+        bool open(const std::string &path) {
+            close();
+#if defined(_WIN32)
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                return false;
+            LARGE_INTEGER file_size;
+            if (GetFileType(file) != FILE_TYPE_DISK or !GetFileSizeEx(file, &file_size) or file_size.QuadPart <= 0) {
+                CloseHandle(file);
+                return false;
+            }
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            CloseHandle(file);
+            if (!mapping)
+                return false;
+            void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping); // Отображение живет, пока открыт view
+            if (!view)
+                return false;
+            data_ = static_cast<const char *>(view);
+            size_ = static_cast<std::size_t>(file_size.QuadPart);
+#else
+            int descriptor = ::open(path.c_str(), O_RDONLY);
+            if (descriptor < 0)
+                return false;
+            struct stat status {};
+            if (fstat(descriptor, &status) != 0 or !S_ISREG(status.st_mode) or status.st_size <= 0) {
+                ::close(descriptor);
+                return false;
+            }
+            std::size_t size = static_cast<std::size_t>(status.st_size);
+            void *view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            ::close(descriptor);
+            if (view == MAP_FAILED)
+                return false;
+#  if defined(POSIX_MADV_SEQUENTIAL)
+            posix_madvise(view, size, POSIX_MADV_SEQUENTIAL);
+#  endif
+            data_ = static_cast<const char *>(view);
+            size_ = size;
+#endif
+            return true;
+        }
+
+        void close() noexcept {
+            if (!data_)
+                return;
+#if defined(_WIN32)
+            UnmapViewOfFile(data_);
+#else
+            munmap(const_cast<char *>(data_), size_);
+#endif
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+        bool isOpen() const noexcept { return data_ != nullptr; }
+        const char *data() const noexcept { return data_; }
+        std::size_t size() const noexcept { return size_; }
+        const char *begin() const noexcept { return data_; }
+        const char *end() const noexcept { return data_ + size_; }
+
+    private:
+        const char *data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_MODEL_DATAREADER_MAPPED_FILE_H_
@@ -0,0 +1,396 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_MODEL_DATAREADER_NUMBER_PARSER_H_
+#define STATISTIC_ANALYZER_MODEL_DATAREADER_NUMBER_PARSER_H_
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <system_error>
+
+#include "parse_errors.h"
+
+#if defined(__GNUC__)
+    #define S21_ALWAYS_INLINE __attribute__((always_inline)) inline
+#else
+    #define S21_ALWAYS_INLINE inline
+#endif
+
+namespace s21 {
+    /**
+     * @struct NumberFormat
+     * Запись чисел в файле: decimal - десятичный разделитель ('.' или ','),\n
+     * thousands - разделитель групп разрядов ('\\0' - нет, '.', ',', '\\'')\n
+     * Разделитель групп принимается только перед ровно тремя цифрами целой части: 1.234.567,89
+     */
+    struct NumberFormat {
+        char decimal = '.';
+        char thousands = '\0';
+
+        bool isDefault() const noexcept { return decimal == '.' and !thousands; }
+        bool operator==(const NumberFormat &other) const noexcept { return decimal == other.decimal and thousands == other.thousands; }
+        bool operator!=(const NumberFormat &other) const noexcept { return !(*this == other); }
+    };
+
+    /**
+     * @class NumberParser class разбирает числа, разделенные пробельными символами,\n
+     * из блока символов без участия локали и потоков ввода\n\n
+     * @methods
+     * a) parse(begin, end, last_block, sink) -> разбирает блок [begin, end), каждое число передается в sink(double),\n
+     *      возвращает позицию, с которой нужно продолжить разбор в следующем блоке (незаконченное число в конце блока),\n
+     *      если last_block == true, блок разбирается до конца\n
+     * b) stopped() -> встретилось некорректное значение, дальнейший разбор прекращен\n
+     *      (как и у std::istream_iterator<double>, все значения до него сохраняются)\n
+     *      После skipInvalid(max_errors) некорректные значения (вся запись до пробельного символа) пропускаются,\n
+     *      разбор не прекращается, а errors() хранит их количество и позиции первых max_errors из них\n
+     * c) parseToken(begin, end, value[, format]) -> разбирает одно число, занимающее весь диапазон\n
+     * d) detectFormat(begin, end[, delimiter]) -> определяет NumberFormat по образцу текста\n\n
+     * NumberParser() - запись как у operator>>(double) в локали "C",\n
+     * NumberParser(format) - заданная запись, std::nullopt - запись определяется по первому разбираемому блоку
+     */
+    class NumberParser final {
+    public:
+        static constexpr std::size_t kDetectSize = 1 << 16; // Байт начала файла, по которым определяется запись
+
+    public:
+        NumberParser() = default;
+        explicit NumberParser(std::optional<NumberFormat> format)
+            : format_(format.value_or(NumberFormat{})), detect_(!format) {}
+
+    public:
+        template <typename Sink>
+        const char *parse(const char *begin, const char *end, bool last_block, Sink &&sink) {
+            if (detect_) {
+                format_ = detectFormat(begin, begin + std::min<std::size_t>(static_cast<std::size_t>(end - begin), kDetectSize));
+                detect_ = false;
+            }
+            if (!skip_)
+                return parseBlock<false>(begin, end, last_block, sink);
+            errors_.beginBlock(begin);
+            const char *stop = parseBlock<true>(begin, end, last_block, sink);
+            if (!last_block and !errors_.full())
+                errors_.endBlock(stop);
+            return stop;
+        }
+
+        bool stopped() const noexcept { return stopped_; }
+
+        void skipInvalid(std::size_t max_errors) {
+            skip_ = true;
+            errors_ = ParseErrorLog(max_errors);
+        }
+
+        ParseErrorLog &errors() noexcept { return errors_; }
+        const ParseErrorLog &errors() const noexcept { return errors_; }
+
+        /**
+         * Запись, по которой разбирается файл (после первого блока - в том числе определенная автоматически)
+         */
+        const NumberFormat &format() const noexcept { return format_; }
+
+        /**
+         * Разбирает одно число, занимающее весь диапазон [begin, end) (например, поле CSV)
+         */
+        static bool parseToken(const char *begin, const char *end, double &value, const NumberFormat &format = {}) noexcept {
+            return begin != end and parseValue(begin, end, value, format) == end;
+        }
+
+        /**
+         * @brief detectFormat
+         * Определяет десятичный разделитель и разделитель групп разрядов по числам в [begin, end)\n
+         * Числа отделяются пробельными символами и delimiter (поля в кавычках берутся целиком), остальное пропускается\n
+         * Однозначные признаки: оба разделителя в одном числе (последний - десятичный), повторяющийся разделитель\n
+         * (1.234.567 - группы разрядов), не три цифры после единственного разделителя (12,5 - десятичный)\n
+         * Если все числа вида 1,234 / 1.234, разделитель считается десятичным
+         */
+        static NumberFormat detectFormat(const char *begin, const char *end, char delimiter = '\0') noexcept {
+            std::size_t votes[2] {}, ambiguous[2] {}, thousands[3] {}; // [0] - '.', [1] - ',', [2] - '\''
+            const char *current = begin;
+            while (current != end) {
+                if (isSpace(*current) or *current == delimiter) {
+                    ++current;
+                    continue;
+                }
+                const char *token = current, *token_end;
+                if (*current == '"') {
+                    token = current + 1;
+                    token_end = static_cast<const char *>(std::memchr(token, '"', static_cast<std::size_t>(end - token)));
+                    if (!token_end)
+                        token_end = end;
+                    current = token_end != end ? token_end + 1 : end;
+                } else {
+                    while (current != end and !isSpace(*current) and *current != delimiter)
+                        ++current;
+                    token_end = current;
+                }
+
+                std::size_t separators[3] {}, digits = 0, segment = 0, first_segment = 0;
+                char last_separator = '\0';
+                bool numeric = true, grouped = true;
+                for (const char *symbol = token; symbol != token_end and numeric; ++symbol) {
+                    if (digitValue(*symbol) < 10) {
+                        ++digits, ++segment;
+                    } else if (*symbol == '.' or *symbol == ',' or *symbol == '\'') {
+                        if (last_separator)
+                            grouped = grouped and segment == 3;
+                        else
+                            first_segment = segment;
+                        ++separators[separatorIndex(*symbol)];
+                        last_separator = *symbol;
+                        segment = 0;
+                    } else {
+                        numeric = (*symbol == '-' or *symbol == '+') and symbol == token;
+                    }
+                }
+                if (!numeric or !digits or !last_separator)
+                    continue;
+
+                std::size_t last = separatorIndex(last_separator), count = separators[0] + separators[1] + separators[2];
+                if (count == 1) {
+                    if (last != 2)
+                        ++(segment == 3 ? ambiguous : votes)[last];
+                    continue;
+                }
+                if (!grouped or !first_segment or first_segment > 3)
+                    continue; // Не число с группами разрядов (например, дата 01.02.2024)
+                if (separators[last] == count) { // 1.234.567 - все разделители отделяют группы
+                    if (segment != 3)
+                        continue;
+                    ++thousands[last];
+                    if (last != 2)
+                        ++votes[!last];
+                } else if (separators[last] == 1 and last != 2) { // 1.234.567,89 - последний разделитель десятичный
+                    std::size_t group = 0;
+                    while (group != 3 and (group == last or separators[group] != count - 1))
+                        ++group;
+                    if (group == 3)
+                        continue;
+                    ++votes[last];
+                    ++thousands[group];
+                }
+            }
+
+            NumberFormat format;
+            if (votes[1] > votes[0] or (!votes[0] and ambiguous[1] > ambiguous[0]))
+                format.decimal = ',';
+            if (thousands[2])
+                format.thousands = '\'';
+            else if (format.decimal == ',' and thousands[0])
+                format.thousands = '.';
+            else if (format.decimal == '.' and thousands[1])
+                format.thousands = ',';
+            return format;
+        }
+
+        static bool isSpace(char symbol) noexcept {
+            return symbol == ' ' or symbol == '\n' or symbol == '\t' or symbol == '\r' or symbol == '\v' or symbol == '\f';
+        }
+
+    private:
+        NumberFormat format_;
+        bool detect_ = false;
+        bool stopped_ = false;
+        bool skip_ = false;
+        ParseErrorLog errors_;
+
+    private:
+        /**
+         * kSkip - режим пропуска выбирается при компиляции, чтобы не добавлять проверок в цикл обычного разбора
+         */
+        template <bool kSkip, typename Sink>
+        const char *parseBlock(const char *begin, const char *end, bool last_block, Sink &&sink) {
+            const char *current = begin;
+            while (!stopped_) {
+                while (current != end and isSpace(*current))
+                    ++current;
+                if (current == end)
+                    return current;
+
+                double value;
+                const char *next = parseValue(current, end, value, format_);
+                // Запись без пробельного символа до конца блока может продолжаться в следующем блоке ("1.5e" + "+10",
+                // "1," + "234.5"): переносится целиком, даже если ее начало уже разбирается как число
+                if (!last_block and (!next or next == end or !isSpace(*next)) and !containsSpace(next ? next : current, end))
+                    return current;
+                if (!next or (kSkip and next != end and !isSpace(*next))) {
+                    if (!kSkip) {
+                        stopped_ = true;
+                        return current;
+                    }
+                    const char *token_end = next ? next : current;
+                    while (token_end != end and !isSpace(*token_end))
+                        ++token_end;
+                    if (token_end == end and !last_block)
+                        return current;
+                    errors_.report(current, token_end);
+                    current = token_end;
+                    continue;
+                }
+                sink(value);
+                current = next;
+            }
+            return current;
+        }
+
+        static bool containsSpace(const char *begin, const char *end) noexcept {
+            for (; begin != end; ++begin)
+                if (isSpace(*begin))
+                    return true;
+            return false;
+        }
+
+        static unsigned digitValue(char symbol) noexcept { return static_cast<unsigned>(symbol - '0'); }
+
+        static std::size_t separatorIndex(char separator) noexcept { return separator == '.' ? 0 : separator == ',' ? 1 : 2; }
+
+        /**
+         * Быстрый путь для обычных десятичных записей без экспоненты (до 19 цифр):\n
+         * если мантисса <= 2^53 и степень десяти <= 22, то одно деление дает\n
+         * корректно округленный результат (Clinger), совпадающий с std::from_chars\n
+         * Разделители format проверяются в том же проходе по цифрам\n
+         * Встраивается принудительно (как и parseValue): у функций несколько вызывающих,\n
+         * и без этого компилятор выносит быстрый путь из цикла разбора
+         * @return
+         * Позиция за числом или nullptr, если запись не подходит для быстрого пути
+         */
+        S21_ALWAYS_INLINE static const char *parseSimple(const char *begin, const char *end, double &value, const NumberFormat &format) noexcept {
+            static constexpr double kPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                                      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+            const char *current = begin;
+            bool negative = *current == '-';
+            if (negative)
+                ++current;
+            std::uint64_t mantissa = 0;
+            std::ptrdiff_t digits = 0, fraction_digits = 0;
+            for (; current != end; ++current) {
+                unsigned digit = digitValue(*current);
+                if (digit < 10) {
+                    mantissa = mantissa * 10 + digit;
+                    ++digits;
+                } else if (!format.thousands or *current != format.thousands or !isGroupSeparator(current, end, digits)) {
+                    break;
+                }
+            }
+            if (current != end and *current == format.decimal) {
+                const char *fraction = ++current;
+                for (unsigned digit; current != end and (digit = digitValue(*current)) < 10; ++current)
+                    mantissa = mantissa * 10 + digit;
+                fraction_digits = current - fraction;
+                digits += fraction_digits;
+            }
+            if (!digits or digits > 19 or fraction_digits > 22 or mantissa > (std::uint64_t{1} << 53))
+                return nullptr;
+            if (current != end and (*current == 'e' or *current == 'E'))
+                return nullptr;
+            value = static_cast<double>(mantissa);
+            if (fraction_digits)
+                value /= kPowersOfTen[fraction_digits];
+            if (negative)
+                value = -value;
+            return current;
+        }
+
+        /**
+         * Разделитель групп в separator допустим, если перед ним 1-3 цифры (первая группа) или группа из 3 цифр,\n
+         * а после него ровно три цифры
+         */
+        static bool isGroupSeparator(const char *separator, const char *end, std::ptrdiff_t digits_before) noexcept {
+            if (!digits_before or end - separator < 4)
+                return false;
+            if (digitValue(separator[1]) >= 10 or digitValue(separator[2]) >= 10 or digitValue(separator[3]) >= 10)
+                return false;
+            if (end - separator > 4 and digitValue(separator[4]) < 10)
+                return false;
+            if (digits_before > 3) // Перед вторым и следующими разделителями - группа из трех цифр
+                return separator[-4] == separator[0];
+            return true;
+        }
+
+        /**
+         * Формат совпадает с operator>>(double): необязательный знак, цифры, точка, экспонента\n
+         * (десятичный разделитель и разделитель групп - из format), inf и nan не принимаются
+         * @return
+         * Позиция за числом или nullptr, если число некорректно
+         */
+        S21_ALWAYS_INLINE static const char *parseValue(const char *begin, const char *end, double &value, const NumberFormat &format = {}) noexcept {
+            const char *current = begin;
+            if (*current == '+') {
+                ++current;
+                if (current == end or *current == '-' or *current == '+')
+                    return nullptr;
+            }
+            const char *digits = current != end and *current == '-' ? current + 1 : current;
+            if (digits == end or !((*digits >= '0' and *digits <= '9') or *digits == format.decimal))
+                return nullptr;
+            if (const char *next = parseSimple(current, end, value, format))
+                return next;
+            if (!format.isDefault())
+                return parseNormalized(current, end, value, format);
+            return parseStandard(current, end, value);
+        }
+
+        /**
+         * Запись с разделителями format копируется в запись с точкой без групп разрядов и разбирается parseStandard
+         */
+        static const char *parseNormalized(const char *begin, const char *end, double &value, const NumberFormat &format) noexcept {
+            char token[128];
+            const char *positions[sizeof(token)]; // positions[i] - позиция в исходной записи за символом token[i]
+            std::size_t length = 0;
+            std::ptrdiff_t digits = 0;
+            bool integer = true;
+            for (const char *current = begin; current != end and length != sizeof(token) - 1; ++current) {
+                char symbol = *current;
+                if (integer and format.thousands and symbol == format.thousands and isGroupSeparator(current, end, digits))
+                    continue;
+                if (symbol == format.decimal)
+                    symbol = '.', integer = false;
+                else if (symbol == '.' or symbol == ',' or isSpace(symbol))
+                    break;
+                else if (symbol == 'e' or symbol == 'E')
+                    integer = false;
+                digits += digitValue(symbol) < 10;
+                token[length] = symbol;
+                positions[length++] = current + 1;
+            }
+            const char *next = parseStandard(token, token + length, value);
+            if (!next)
+                return nullptr;
+            return next == token ? begin : positions[next - token - 1];
+        }
+
+        static const char *parseStandard(const char *current, const char *end, double &value) noexcept {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            auto [next, error] = std::from_chars(current, end, value);
+            if (error != std::errc{})
+                return nullptr;
+            return next;
+#else
+            char token[128];
+            std::size_t length = 0;
+            while (current + length != end and length != sizeof(token) - 1 and !isSpace(current[length]))
+                ++length;
+            std::memcpy(token, current, length);
+            token[length] = '\0';
+            char *parsed_end = nullptr;
+            value = std::strtod(token, &parsed_end);
+            if (parsed_end == token)
+                return nullptr;
+            return current + (parsed_end - token);
+#endif
+        }
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_MODEL_DATAREADER_NUMBER_PARSER_H_
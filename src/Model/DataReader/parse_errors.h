@@ -0,0 +1,134 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_MODEL_DATAREADER_PARSE_ERRORS_H_
+#define STATISTIC_ANALYZER_MODEL_DATAREADER_PARSE_ERRORS_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+namespace s21 {
+    /**
+     * @struct ParseError
+     * Пропущенное некорректное значение: строка и столбец (с 1, столбец - в байтах от начала строки)\n
+     * и начало самого значения (не длиннее ParseErrorLog::kTokenSize символов)
+     */
+    struct ParseError {
+        std::size_t line;
+        std::size_t column;
+        std::string token;
+    };
+
+    /**
+     * @class ParseErrorLog\n
+     * Считает пропущенные парсером значения и запоминает позиции первых max_errors из них\n\n
+     * Строки считаются лениво, только в режиме пропуска: report() досчитывает переводы строк от прошлой ошибки\n
+     * до новой, endBlock() - до конца разобранной части блока (блок после этого может быть перезаписан),\n
+     * поэтому каждый байт файла просматривается не больше одного раза, а после max_errors ошибок строки\n
+     * не считаются вовсе\n\n
+     * append(next, next_begin) - присоединяет журнал парсера, разбиравшего тот же буфер с next_begin\n
+     * (части параллельного чтения отображенного файла); строки между частями досчитываются,\n
+     * только если в next есть запоминаемые ошибки, поэтому в чистом файле они не считаются совсем\n\n
+     * Copyable, moveable, final class
+     */
+    class ParseErrorLog final {
+    public:
+        static constexpr std::size_t kTokenSize = 32;
+
+    public:
+        explicit ParseErrorLog(std::size_t max_errors = 16) : max_errors_(max_errors) {}
+
+    public:
+        void beginBlock(const char *begin) noexcept {
+            block_begin_ = counted_ = begin;
+            line_start_ = nullptr;
+        }
+
+        void report(const char *token, const char *token_end) {
+            ++count_;
+            if (full())
+                return;
+            countLines(token);
+            std::size_t column = columnOf(token);
+            std::size_t size = std::min(static_cast<std::size_t>(token_end - token), kTokenSize);
+            errors_.push_back(ParseError{line_, column + 1, std::string(token, size)});
+        }
+
+        /**
+         * Разбор блока закончился на stop, следующий блок начнется с того же символа
+         */
+        void endBlock(const char *stop) noexcept {
+            countLines(stop);
+            carry_ = columnOf(stop);
+        }
+
+        /**
+         * next - журнал парсера, разбор которого начался с beginBlock(next_begin) в том же буфере, что и у этого журнала,\n
+         * next_begin не раньше всего, что уже разобрано этим журналом
+         */
+        void append(const ParseErrorLog &next, const char *next_begin) {
+            count_ += next.count_;
+            if (full() or next.errors_.empty())
+                return;
+            countLines(next_begin);
+            std::size_t carry = columnOf(next_begin);
+            for (auto error : next.errors_) {
+                if (full())
+                    break;
+                if (error.line == 1)
+                    error.column += carry;
+                error.line += line_ - 1;
+                errors_.push_back(std::move(error));
+            }
+            // next уже посчитал строки до своей последней ошибки, дальше счет продолжается с его позиции
+            line_ += next.line_ - 1;
+            if (next.line_start_)
+                line_start_ = next.line_start_;
+            counted_ = next.counted_;
+        }
+
+        bool full() const noexcept { return errors_.size() >= max_errors_; }
+        std::size_t count() const noexcept { return count_; }
+        const std::vector<ParseError> &errors() const noexcept { return errors_; }
+
+    private:
+        std::size_t max_errors_;
+        std::size_t count_ = 0;
+        std::vector<ParseError> errors_;
+        std::size_t line_ = 1;
+        std::size_t carry_ = 0;              // Символов текущей строки в предыдущих блоках
+        const char *block_begin_ = nullptr;
+        const char *line_start_ = nullptr;   // Начало текущей строки, если она началась в этом блоке
+        const char *counted_ = nullptr;      // Переводы строк до этой позиции уже посчитаны
+
+    private:
+        std::size_t columnOf(const char *position) const noexcept {
+            return line_start_ ? static_cast<std::size_t>(position - line_start_) : carry_ + static_cast<std::size_t>(position - block_begin_);
+        }
+
+        void countLines(const char *position) noexcept {
+            if (counted_ >= position)
+                return;
+            if (auto newlines = static_cast<std::size_t>(std::count(counted_, position, '\n'))) {
+                line_ += newlines;
+                line_start_ = position;
+                while (line_start_[-1] != '\n')
+                    --line_start_;
+            }
+            counted_ = position;
+        }
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_MODEL_DATAREADER_PARSE_ERRORS_H_
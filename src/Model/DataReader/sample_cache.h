@@ -0,0 +1,250 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_MODEL_DATAREADER_SAMPLE_CACHE_H_
+#define STATISTIC_ANALYZER_MODEL_DATAREADER_SAMPLE_CACHE_H_
+
+#include <vector>
+#include <string>
+#include <cctype>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <array>
+#include <optional>
+#include <filesystem>
+
+#include "mapped_file.h"
+#include "number_parser.h"
+#include "../LaboratoryEngine/moment_accumulator.h"
+
+namespace s21 {
+    /**
+     * @class SampleCache\n
+     * Двоичный кэш выборки (.sab), который пишется рядом с исходным текстовым файлом: path + ".sab"\n
+     * Для столбца CSV файла ключом служит имя столбца: path + "." + key + ".sab"\n\n
+     * Формат (little-endian): заголовок SampleCacheHeader на kDataOffset байт, затем count значений double\n
+     * Заголовок хранит тип значений, флаг упорядоченности, размер и время изменения исходного файла\n
+     * (с точностью файловой системы, а не до секунды: файл, перезаписанный в ту же секунду, не совпадет с кэшем),\n
+     * контрольную сумму значений и состояние MomentAccumulator, поэтому моменты при загрузке не пересчитываются,\n
+     * а также запись чисел (NumberFormat), по которой был разобран исходный файл\n\n
+     * save(source, ...) - записывает кэш (через временный файл), false если записать не удалось\n\n
+     * load(source) - отображает кэш в память и возвращает его содержимое, std::nullopt если кэша нет,\n
+     * он поврежден или исходный файл изменился (другой размер или время изменения)\n\n
+     * Тот же формат без исходного файла (размер и время изменения источника нулевые) - двоичная выборка,\n
+     * которую пишет StatisticAnalyzerGenerator --format binary: loadSample(path) читает ее по собственному пути,\n
+     * header() и Checksum позволяют записать такой файл потоком, не держа значения в памяти
+     */
+    class SampleCache final {
+    public:
+        static constexpr std::uint32_t kVersion = 2; // 2 - время изменения в тиках file_time_type, запись чисел
+        static constexpr std::uint32_t kFloat64 = 1;
+        static constexpr std::uint32_t kSortedFlag = 1;
+        static constexpr std::size_t kDataOffset = 128;
+
+        struct Entry {
+            std::vector<double> statistic;
+            bool sorted = false;
+            MomentAccumulator moments;
+            NumberFormat number_format;
+        };
+
+        /**
+         * Контрольная сумма Флетчера над 64-битными словами значений: один проход, скорость памяти\n
+         * Значения можно добавлять частями, результат не зависит от разбиения
+         */
+        class Checksum final {
+        public:
+            void push(const double *data, std::size_t size) noexcept {
+                for (std::size_t current = 0; current != size; ++current) {
+                    std::uint64_t word;
+                    std::memcpy(&word, data + current, sizeof(word));
+                    low_ += word;
+                    high_ += low_;
+                }
+            }
+
+            std::uint64_t value() const noexcept { return low_ ^ (high_ * 0x9E3779B97F4A7C15ull); }
+
+        private:
+            std::uint64_t low_ = 0, high_ = 0;
+        };
+
+    public:
+        static std::string cachePath(const std::string &source_path, const std::string &key = {}) {
+            std::string path = source_path;
+            if (!key.empty()) {
+                path += '.';
+                for (char symbol : key) // Имя столбца может содержать символы, недопустимые в имени файла
+                    path += std::isalnum(static_cast<unsigned char>(symbol)) or symbol == '-' or symbol == '_' ? symbol : '_';
+            }
+            return path + ".sab";
+        }
+
+        static bool save(const std::string &source_path, const std::vector<double> &statistic,
+                         bool sorted, const MomentAccumulator &moments, const NumberFormat &number_format = {},
+                         const std::string &key = {}) {
+            SourceStatus source;
+            if (!sourceStatus(source_path, source))
+                return false;
+            Checksum checksum;
+            checksum.push(statistic.data(), statistic.size());
+            auto header = SampleCache::header(statistic.size(), checksum.value(), sorted, moments, number_format, source);
+
+            std::string path = cachePath(source_path, key), temporary_path = path + ".tmp";
+            {
+                std::ofstream fout(temporary_path, std::ios::binary | std::ios::trunc);
+                if (!fout.is_open())
+                    return false;
+                fout.write(header.data(), static_cast<std::streamsize>(header.size()));
+                fout.write(reinterpret_cast<const char *>(statistic.data()),
+                           static_cast<std::streamsize>(statistic.size() * sizeof(double)));
+                if (!fout.good()) {
+                    fout.close();
+                    std::remove(temporary_path.c_str());
+                    return false;
+                }
+            }
+            std::remove(path.c_str()); // std::rename не заменяет существующий файл на Windows
+            if (std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+                std::remove(temporary_path.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        static std::optional<Entry> load(const std::string &source_path, const std::string &key = {}) {
+            SourceStatus source;
+            if (!sourceStatus(source_path, source))
+                return std::nullopt;
+            return loadFile(cachePath(source_path, key), &source);
+        }
+
+        /**
+         * @brief loadSample
+         * Читает двоичную выборку по ее собственному пути, исходный файл не проверяется
+         */
+        static std::optional<Entry> loadSample(const std::string &path) { return loadFile(path, nullptr); }
+
+        /**
+         * Начинаются ли данные с заголовка SampleCache (двоичная выборка или кэш)
+         */
+        static bool isSample(const char *data, std::size_t size) noexcept {
+            return size >= sizeof(kMagic) and std::memcmp(data, kMagic, sizeof(kMagic)) == 0;
+        }
+
+        /**
+         * @brief header
+         * Заголовок файла с count значениями, записываемыми сразу за ним (kDataOffset байт)
+         */
+        static std::array<char, kDataOffset> header(std::uint64_t count, std::uint64_t checksum, bool sorted, const MomentAccumulator &moments,
+                                                    const NumberFormat &number_format = {}) {
+            return header(count, checksum, sorted, moments, number_format, SourceStatus{0, 0});
+        }
+
+    private:
+        static constexpr char kMagic[8] = {'S', '2', '1', 'S', 'A', 'B', '\r', '\n'};
+
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t dtype;
+            std::uint32_t flags;
+            std::uint32_t data_offset;
+            std::uint64_t count;
+            std::uint64_t source_size;
+            std::int64_t source_mtime;
+            std::uint64_t checksum;
+            std::uint64_t moments_count;
+            double sum, minimum, maximum, mean, m2, m3, m4;
+            char decimal, thousands;
+            char reserved[6];
+        };
+        static_assert(sizeof(Header) == kDataOffset, "SampleCache header must occupy exactly kDataOffset bytes");
+
+        struct SourceStatus {
+            std::uint64_t size;
+            std::int64_t mtime;
+        };
+
+        static std::array<char, kDataOffset> header(std::uint64_t count, std::uint64_t checksum, bool sorted, const MomentAccumulator &moments,
+                                                    const NumberFormat &number_format, const SourceStatus &source) {
+            auto state = moments.state();
+            Header header {};
+            std::memcpy(header.magic, kMagic, sizeof(header.magic));
+            header.version = kVersion;
+            header.dtype = kFloat64;
+            header.flags = sorted ? kSortedFlag : 0;
+            header.data_offset = static_cast<std::uint32_t>(kDataOffset);
+            header.count = count;
+            header.source_size = source.size;
+            header.source_mtime = source.mtime;
+            header.checksum = checksum;
+            header.moments_count = state.count;
+            header.sum = state.sum, header.minimum = state.minimum, header.maximum = state.maximum;
+            header.mean = state.mean, header.m2 = state.m2, header.m3 = state.m3, header.m4 = state.m4;
+            header.decimal = number_format.decimal, header.thousands = number_format.thousands;
+            std::array<char, kDataOffset> bytes;
+            std::memcpy(bytes.data(), &header, sizeof(header));
+            return bytes;
+        }
+
+        /**
+         * source == nullptr - двоичная выборка, размер и время изменения источника не сверяются
+         */
+        static std::optional<Entry> loadFile(const std::string &path, const SourceStatus *source) {
+            MappedFile file(path);
+            if (!file.isOpen() or file.size() < kDataOffset)
+                return std::nullopt;
+
+            Header header;
+            std::memcpy(&header, file.data(), sizeof(header));
+            if (std::memcmp(header.magic, kMagic, sizeof(header.magic)) != 0 or header.version != kVersion
+                or header.dtype != kFloat64 or header.data_offset != kDataOffset
+                or (source and (header.source_size != source->size or header.source_mtime != source->mtime))
+                or header.count != (file.size() - kDataOffset) / sizeof(double)
+                or (file.size() - kDataOffset) % sizeof(double))
+                return std::nullopt;
+
+            Entry entry;
+            entry.statistic.resize(header.count);
+            std::memcpy(entry.statistic.data(), file.data() + kDataOffset, header.count * sizeof(double));
+            Checksum checksum;
+            checksum.push(entry.statistic.data(), entry.statistic.size());
+            if (checksum.value() != header.checksum)
+                return std::nullopt;
+            entry.sorted = header.flags & kSortedFlag;
+            entry.number_format = NumberFormat{header.decimal, header.thousands};
+            entry.moments = MomentAccumulator(MomentAccumulator::State{header.moments_count, header.sum, header.minimum,
+                                                                       header.maximum, header.mean, header.m2, header.m3, header.m4});
+            return entry;
+        }
+
+        /**
+         * mtime - тики std::filesystem::file_time_type (наносекунды в libstdc++, 100 нс в MSVC)
+         */
+        static bool sourceStatus(const std::string &path, SourceStatus &status) {
+            std::error_code error;
+            auto size = std::filesystem::file_size(path, error);
+            if (error)
+                return false;
+            auto mtime = std::filesystem::last_write_time(path, error);
+            if (error)
+                return false;
+            status.size = static_cast<std::uint64_t>(size);
+            status.mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+            return true;
+        }
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_MODEL_DATAREADER_SAMPLE_CACHE_H_
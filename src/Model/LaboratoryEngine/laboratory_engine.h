@@ -16,10 +16,16 @@
 
 #include <cmath>
 #include <vector>
+#include <cstdint>
 #include <numeric>
 #include <iostream>
 #include <algorithm>
 
+#include "moment_accumulator.h"
+#include "statistic_histogram.h"
+#include "statistic_sorter.h"
+#include "../Profiler/stage_profiler.h"
+
 namespace s21 {
     /**
      * @class LaboratoryStatisticEngine\n
@@ -31,28 +37,101 @@ namespace s21 {
      * Рассчитывает математическое ожидание выборки statisticMean()\n\n
      * Рассчитывает средне-квадратичное отклонение выборки statisticMeanQuadraticDeviation()\n\n
      * Возможность получения максимального/минимального значения выборки statisticMinimum(Maximum)Value()\n\n
+     * Рассчитывает все сводные характеристики выборки за один проход statisticSummary()\n\n
+     * Строит гистограмму с равными корзинами statisticHistogram()\n\n
+     * Дописывает значения в конец выборки appendStatistic(), моменты и гистограмма обновляются по новым значениям\n\n
+     * Производные величины (моменты, интервалы, точки графиков) кэшируются с номером версии\n
+     * и пересчитываются лениво, только если с тех пор изменилась выборка или количество интервалов\n\n
+     * Пересчеты (sort, intervals, moments, histogram, кривые, append, erase) отмечены стадиями StageProfile\n\n
      */
     class LaboratoryStatisticEngine final {
     public:
         using statistic_type = std::vector<double>;
         using statistic_value_type = statistic_type::value_type;
         using statistic_size_type = statistic_type::size_type;
+        using interval_range_type = std::pair<statistic_size_type, statistic_size_type>; // {offset, length} в statistic_
 
     public:
         LaboratoryStatisticEngine() = default;
-        explicit LaboratoryStatisticEngine(const statistic_type &statistic) : statistic_(statistic) {}
-        explicit LaboratoryStatisticEngine(statistic_type &&statistic) : statistic_(std::move(statistic)) {}
+        explicit LaboratoryStatisticEngine(const statistic_type &statistic) : statistic_(statistic), sorted_(checkSorted()) {}
+        explicit LaboratoryStatisticEngine(statistic_type &&statistic) : statistic_(std::move(statistic)), sorted_(checkSorted()) {}
 
     public:
-        void statistic(const statistic_type &statistic) { statistic_ = statistic; }
-        void statistic(statistic_type &&statistic) noexcept { statistic_ = std::move(statistic); }
-        void intervalsCount(statistic_size_type intervals_count) noexcept { intervals_count_ = intervals_count; }
+        void statistic(const statistic_type &statistic) { statistic_ = statistic; sorted_ = checkSorted(); statisticChanged(); }
+        void statistic(statistic_type &&statistic) noexcept { statistic_ = std::move(statistic); sorted_ = checkSorted(); statisticChanged(); }
+
+        /**
+         * @brief restoreStatistic
+         * Устанавливает выборку вместе с заранее известными упорядоченностью и моментами\n
+         * (например, из SampleCache) - проверка упорядоченности и первый расчет моментов пропускаются
+         */
+        void restoreStatistic(statistic_type &&statistic, bool sorted, const MomentAccumulator &moments) noexcept {
+            statistic_ = std::move(statistic);
+            sorted_ = sorted;
+            statisticChanged();
+            moments_.value = moments;
+            moments_.version = values_version_;
+        }
+
+        /**
+         * @brief appendStatistic
+         * Дописывает size значений в выборку (например, новые строки дописываемого файла)\n
+         * Отсортированная выборка остается отсортированной: сортируются только новые значения и сливаются с выборкой\n
+         * Рассчитанные моменты дополняются новыми значениями, рассчитанная гистограмма - тоже,\n
+         * если новые значения не вышли за ее границы, поэтому старая часть выборки повторно не просматривается
+         */
+        void appendStatistic(const statistic_value_type *data, statistic_size_type size) {
+            if (!size)
+                return;
+            S21_PROFILE_SCOPE("append");
+            S21_PROFILE_COUNT(size);
+            bool moments_valid = moments_.version == values_version_;
+            bool histogram_valid = histogram_.version == values_version_;
+            auto middle = statistic_.insert(statistic_.end(), data, data + size);
+            if (sorted_) {
+                std::sort(middle, statistic_.end(), statisticLess);
+                std::inplace_merge(statistic_.begin(), middle, statistic_.end(), statisticLess);
+            }
+            statisticChanged();
+
+            if (moments_valid) {
+                MomentAccumulator appended;
+                appended.push(data, size);
+                if (histogram_valid)
+                    histogram_valid = appended.minimum() >= histogram_.value.minimum() and appended.maximum() <= histogram_.value.maximum();
+                moments_.value.merge(appended);
+                moments_.version = values_version_;
+            }
+            if (histogram_valid and moments_valid) {
+                histogram_.value.push(data, size);
+                histogram_.version = values_version_;
+            }
+        }
+
+        void appendStatistic(const statistic_type &statistic) { appendStatistic(statistic.data(), statistic.size()); }
+
+        void intervalsCount(statistic_size_type intervals_count) noexcept {
+            if (intervals_count != intervals_count_)
+                ++layout_version_;
+            intervals_count_ = intervals_count;
+        }
 
         const statistic_type &statistic() const noexcept { return statistic_; };
         statistic_size_type statisticSize() const noexcept { return statistic_.size(); }
         statistic_value_type statisticMinimumValue() const noexcept { return !statistic_.empty() ? statistic_.front() : statistic_value_type{}; }
         statistic_value_type statisticMaximumValue() const noexcept { return !statistic_.empty() ? statistic_.back() : statistic_value_type{}; }
         statistic_size_type intervalsCount() const noexcept { return intervals_count_; }
+        bool isSorted() const noexcept { return sorted_; }
+
+        /**
+         * Построенные buildIntervals() интервалы: границы [left, right), диапазоны выборки и доли n/N
+         */
+        const std::vector<std::pair<statistic_value_type, statistic_value_type>> &intervalsBorderValues() const noexcept { return intervals_border_values_; }
+        const std::vector<interval_range_type> &statisticIntervals() const noexcept { return statistic_intervals_; }
+        const statistic_type &intervalsRelativeAmount() const noexcept { return relative_amount_; }
+
+        StatisticSorter &sorter() noexcept { return sorter_; }
+        const StatisticSorter &sorter() const noexcept { return sorter_; }
 
         /**
          * @brief isGood
@@ -68,21 +147,25 @@ namespace s21 {
          * @return
          * Возвращает координаты точек x и y
          */
-        std::pair<statistic_type, statistic_type> graphStatisticData() const {
-            if (statistic_.empty())
-                return {};
-            statistic_type x_points, y_points;
-            x_points.push_back(statisticMinimumValue());
-            y_points.push_back(0);
-            for (statistic_size_type current = 0; current != intervals_count_; ++current) {
-                auto min = intervals_border_values_[current].first, max = intervals_border_values_[current].second;
-                x_points.push_back((min + max) / 2);
-                y_points.push_back(relative_amount_[current]);
+        const std::pair<statistic_type, statistic_type> &graphStatisticData() const {
+            if (statistic_curve_.version == intervals_version_)
+                return statistic_curve_.value;
+            S21_PROFILE_SCOPE("statistic curve");
+            auto &[x_points, y_points] = statistic_curve_.value;
+            x_points.clear(), y_points.clear();
+            if (!statistic_.empty()) {
+                x_points.push_back(statisticMinimumValue());
+                y_points.push_back(0);
+                for (statistic_size_type current = 0, size = intervals_border_values_.size(); current != size; ++current) {
+                    auto min = intervals_border_values_[current].first, max = intervals_border_values_[current].second;
+                    x_points.push_back((min + max) / 2);
+                    y_points.push_back(relative_amount_[current]);
+                }
+                x_points.push_back(statisticMaximumValue());
+                y_points.push_back(0);
             }
-            x_points.push_back(statisticMaximumValue());
-            y_points.push_back(0);
-
-            return std::make_pair(x_points, y_points);
+            statistic_curve_.version = intervals_version_;
+            return statistic_curve_.value;
         }
 
         /**
@@ -91,39 +174,58 @@ namespace s21 {
          * @return
          * Возвращает координаты точек x и y
          */
-        std::pair<statistic_type, statistic_type> graphNormalDistributionData() const {
-            if (statistic_.empty())
-                return {};
-            statistic_type x_points, y_points;
-            statistic_value_type x_min = mean_ - std::fabs(3 * quadratic_deviation_);
-            statistic_value_type x_max = mean_ + std::fabs(3 * quadratic_deviation_);
-            statistic_value_type h = calculateIntervalLength();
-            for (auto start = x_min; start <= x_max; start += 0.01) {
-                x_points.push_back(start);
-                double y_point = (h * (1 / (quadratic_deviation_ * std::sqrt(2 * M_PI)))) * std::pow(M_E, -(std::pow(start - mean_, 2)/(2 * std::pow(quadratic_deviation_, 2))));
-                y_points.push_back(y_point);
+        const std::pair<statistic_type, statistic_type> &graphNormalDistributionData() const {
+            if (normal_curve_.version == layout_version_)
+                return normal_curve_.value;
+            S21_PROFILE_SCOPE("normal curve");
+            auto &[x_points, y_points] = normal_curve_.value;
+            x_points.clear(), y_points.clear();
+            if (!statistic_.empty()) {
+                statistic_value_type mean = moments().mean(), quadratic_deviation = moments().deviation();
+                statistic_value_type x_min = mean - std::fabs(3 * quadratic_deviation);
+                statistic_value_type x_max = mean + std::fabs(3 * quadratic_deviation);
+                statistic_value_type h = calculateIntervalLength();
+                for (auto start = x_min; start <= x_max; start += 0.01) {
+                    x_points.push_back(start);
+                    double y_point = (h * (1 / (quadratic_deviation * std::sqrt(2 * M_PI)))) * std::pow(M_E, -(std::pow(start - mean, 2)/(2 * std::pow(quadratic_deviation, 2))));
+                    y_points.push_back(y_point);
+                }
             }
-            return std::make_pair(x_points, y_points);
+            S21_PROFILE_COUNT(x_points.size());
+            normal_curve_.version = layout_version_;
+            return normal_curve_.value;
         }
 
         /**
          * @brief sortStatistic
-         * Метод сортирует по возрастанию данную статистику
+         * Метод сортирует по возрастанию данную статистику\n
+         * Способ сортировки и количество потоков настраиваются через sorter()\n
+         * Уже отсортированная выборка (isSorted()) повторно не сортируется
          */
         void sortStatistic() {
-            std::sort(statistic_.begin(), statistic_.end());
-            dispersion_interval_ = statisticMaximumValue() - statisticMinimumValue();
+            if (!sorted_) {
+                S21_PROFILE_SCOPE("sort");
+                S21_PROFILE_COUNT(statistic_.size());
+                sorter_.sort(statistic_);
+                sorted_ = true;
+                ++layout_version_;
+            }
         }
 
         /**
          * @brief buildIntervals
          * Метод распределяет выборку на n-количество равных интервалов и инициализирует интервалы\n
-         * попавшими в них значениями из выборки
+         * попавшими в них значениями из выборки\n
+         * Ничего не делает, если интервалы уже построены для текущих выборки и количества интервалов
          */
         void buildIntervals() {
             if (statistic_.empty())
                 return;
-            sortStatistic(); // Statistic can be non-sorted
+            sortStatistic(); // Statistic can be non-sorted, no-op if it is already sorted
+            if (intervals_version_ == layout_version_)
+                return;
+            S21_PROFILE_SCOPE("intervals");
+            S21_PROFILE_COUNT(statistic_.size());
             statistic_intervals_.clear();
             relative_amount_.clear();
 
@@ -143,24 +245,39 @@ namespace s21 {
 
             statistic_intervals_.resize(intervals_count_);
             relative_amount_.resize(intervals_count_);
-            statistic_size_type current = 0;
-            for (auto & interval : statistic_intervals_) {
-                std::copy_if(statistic_.begin(), statistic_.end(),
-                             std::back_inserter(interval),
-                             [=] (statistic_value_type v) { return v >= intervals_border_values_[current].first and
-                                                                   v < intervals_border_values_[current].second; });
-                relative_amount_[current] = round(static_cast<double>(interval.size()) / statisticSize(), 0.001);
-                ++current;
+
+            // Выборка отсортирована, поэтому каждый интервал [left, right) - непрерывный диапазон,
+            // границы которого ищутся от конца предыдущего интервала за один проход по выборке
+            auto interval_begin = statistic_.cbegin();
+            for (statistic_size_type current = 0; current != intervals_count_; ++current) {
+                auto [left, right] = intervals_border_values_[current];
+                interval_begin = std::lower_bound(interval_begin, statistic_.cend(), left);
+                auto interval_end = left < right ? std::lower_bound(interval_begin, statistic_.cend(), right) : interval_begin;
+                statistic_intervals_[current] = std::make_pair(static_cast<statistic_size_type>(interval_begin - statistic_.cbegin()),
+                                                               static_cast<statistic_size_type>(interval_end - interval_begin));
+                relative_amount_[current] = round(static_cast<double>(interval_end - interval_begin) / statisticSize(), 0.001);
+                interval_begin = interval_end;
             }
+            intervals_version_ = layout_version_;
         }
 
         /**
          * @brief eraseStatisticValue
-         * Метод удаляет первое найденное value из выборки
-         */        
+         * Метод удаляет первое найденное value из выборки\n
+         * Удаление сохраняет упорядоченность, в отсортированной выборке value ищется бинарным поиском
+         */
         void eraseStatisticValue(statistic_value_type value) {
             if (!isGood())
                 return;
+            S21_PROFILE_SCOPE("erase");
+            if (sorted_) {
+                auto finded = std::lower_bound(statistic_.begin(), statistic_.end(), value);
+                if (finded != statistic_.end() and *finded == value) {
+                    statistic_.erase(finded);
+                    statisticChanged();
+                }
+                return;
+            }
             int finded = -1;
             for (statistic_size_type current = 0, size = statisticSize(); current != size; ++current) {
                 if (statistic_[current] == value) {
@@ -171,6 +288,7 @@ namespace s21 {
             if (finded == -1)
                 return;
             statistic_.erase(statistic_type::const_iterator(&statistic_[finded]));
+            statisticChanged();
         }
 
         /**
@@ -179,9 +297,7 @@ namespace s21 {
          * @return
          * сумму всех значений
          */
-        statistic_value_type statisticSum() const {
-            return std::accumulate(statistic_.begin(), statistic_.end(), statistic_value_type{});
-        }
+        statistic_value_type statisticSum() const { return moments().sum(); }
 
         /**
          * @brief statisticMean
@@ -189,10 +305,7 @@ namespace s21 {
          * @return
          * Математическое ожидание
          */
-        statistic_value_type statisticMean() const {
-            mean_ = statisticSum() / statisticSize();
-            return mean_;
-        }
+        statistic_value_type statisticMean() const { return moments().mean(); }
 
         /**
          * @brief statisticMeanQuadraticDeviation
@@ -200,15 +313,38 @@ namespace s21 {
          * @return
          * Среднеквадратичное отклонение
          */
-        statistic_value_type statisticMeanQuadraticDeviation() const {
-            if (std::isnan(mean_))
-                return 0;
-            statistic_type subdivision;
-            std::transform(statistic_.begin(), statistic_.end(), std::back_inserter(subdivision),
-                           [this](statistic_value_type i) { return std::pow(i - mean_, 2); });
-            statistic_value_type dispersion = std::accumulate(subdivision.begin(), subdivision.end(), statistic_value_type{}) / statisticSize();
-            quadratic_deviation_ = std::sqrt(dispersion);
-            return quadratic_deviation_;
+        statistic_value_type statisticMeanQuadraticDeviation() const { return moments().deviation(); }
+
+        /**
+         * @brief statisticSummary
+         * Метод за один проход по выборке рассчитывает количество, сумму, минимум, максимум,\n
+         * математическое ожидание, дисперсию, асимметрию и эксцесс без временных выделений памяти\n
+         * Центральные моменты накапливаются MomentAccumulator
+         * @return
+         * Сводные характеристики выборки
+         */
+        StatisticSummary statisticSummary() const { return moments().summary(); }
+
+        const MomentAccumulator &statisticMoments() const { return moments(); }
+
+        /**
+         * @brief statisticHistogram
+         * Метод распределяет выборку по bins_count равным корзинам от минимума до максимума выборки\n
+         * В отличие от buildIntervals не требует сортировки и не округляет длину интервала\n
+         * Последняя построенная гистограмма кэшируется
+         * @return
+         * Гистограмма выборки
+         */
+        StatisticHistogram statisticHistogram(statistic_size_type bins_count) const {
+            bins_count = bins_count ? bins_count : 1;
+            if (histogram_.version != values_version_ or histogram_.value.binsCount() != bins_count) {
+                S21_PROFILE_SCOPE("histogram");
+                S21_PROFILE_COUNT(statistic_.size());
+                histogram_.value = StatisticHistogram(moments().minimum(), moments().maximum(), bins_count);
+                histogram_.value.push(statistic_);
+                histogram_.version = values_version_;
+            }
+            return histogram_.value;
         }
 
         /**
@@ -231,33 +367,77 @@ namespace s21 {
         void showStatisticIntervals(std::ostream &out) const {
             statistic_size_type current = 1;
             out.precision(4);
-            for (const auto &vector : statistic_intervals_) {
+            for (const auto &[offset, length] : statistic_intervals_) {
                 auto min = intervals_border_values_[current-1].first, max = intervals_border_values_[current-1].second;
                 out << "Interval #" << current << "\t[min: " << min << ", max: "<< max << ", mid: " << (min + max) / 2 << "]:\t";
-                for (const auto &item : vector) {
-                    out << item << '\t';
+                for (statistic_size_type item = offset; item != offset + length; ++item) {
+                    out << statistic_[item] << '\t';
                 }
-                out << "[n = " << vector.size() << ", n/N = " << relative_amount_[current-1] << "]\n";
+                out << "[n = " << length << ", n/N = " << relative_amount_[current-1] << "]\n";
                 current++;
             }
         }
 
     private:
         statistic_type statistic_;
+        bool sorted_ = false; // Инвариант: statistic_ упорядочена по statisticLess
+        StatisticSorter sorter_;
         statistic_size_type intervals_count_ {};
-        statistic_value_type dispersion_interval_ {};
 
-        std::vector<statistic_type> statistic_intervals_;
+        std::vector<interval_range_type> statistic_intervals_; // Интервалы - диапазоны отсортированной statistic_, без копирования значений
         std::vector<std::pair<statistic_value_type, statistic_value_type>> intervals_border_values_;
         statistic_type relative_amount_;
 
-        mutable statistic_value_type mean_{}, quadratic_deviation_{};
+        /**
+         * values_version_ меняется при изменении значений выборки,\n
+         * layout_version_ - при любом изменении, влияющем на интервалы (значения, порядок, количество интервалов)\n
+         * Кэш с version == 0 еще не рассчитан
+         */
+        template <typename T>
+        struct Cached {
+            T value {};
+            std::uint64_t version {};
+        };
+
+        std::uint64_t values_version_ = 1, layout_version_ = 1;
+        std::uint64_t intervals_version_ {};
+        mutable Cached<MomentAccumulator> moments_;
+        mutable Cached<StatisticHistogram> histogram_;
+        mutable Cached<std::pair<statistic_type, statistic_type>> statistic_curve_, normal_curve_;
 
     private:
+        void statisticChanged() noexcept {
+            ++values_version_;
+            ++layout_version_;
+        }
+
+        const MomentAccumulator &moments() const {
+            if (moments_.version != values_version_) {
+                S21_PROFILE_SCOPE("moments");
+                S21_PROFILE_COUNT(statistic_.size());
+                moments_.value.reset();
+                moments_.value.push(statistic_);
+                moments_.version = values_version_;
+            }
+            return moments_.value;
+        }
+
+        /**
+         * Размах выборки: у отсортированной - разность крайних значений, иначе берется из моментов
+         */
+        statistic_value_type dispersionInterval() const {
+            if (sorted_)
+                return statisticMaximumValue() - statisticMinimumValue();
+            return moments().maximum() - moments().minimum();
+        }
+
+        bool checkSorted() const noexcept { return std::is_sorted(statistic_.begin(), statistic_.end(), statisticLess); }
+
         statistic_value_type calculateIntervalLength() const {
-            if (!intervals_count_ or dispersion_interval_ <= 1e-6)
+            statistic_value_type dispersion_interval = dispersionInterval();
+            if (!intervals_count_ or dispersion_interval <= 1e-6)
                 throw std::runtime_error("Intervals count is zero!");
-            return round(dispersion_interval_ / intervals_count_, 0.001);
+            return round(dispersion_interval / intervals_count_, 0.001);
         }
 
         static statistic_value_type round(statistic_value_type value, double precision = 0.01) {
@@ -0,0 +1,183 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_MODEL_LABORATORYENGINE_MOMENT_ACCUMULATOR_H_
+#define STATISTIC_ANALYZER_MODEL_LABORATORYENGINE_MOMENT_ACCUMULATOR_H_
+
+#include <cmath>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+#include "simd_kernels.h"
+
+namespace s21 {
+    /**
+     * @struct StatisticSummary
+     * Сводные характеристики выборки, рассчитываемые за один проход MomentAccumulator\n
+     * variance - дисперсия (делится на N), skewness - коэффициент асимметрии, kurtosis - коэффициент эксцесса
+     */
+    struct StatisticSummary {
+        std::size_t count {};
+        double sum {};
+        double minimum {};
+        double maximum {};
+        double mean {};
+        double variance {};
+        double skewness {};
+        double kurtosis {};
+    };
+
+    /**
+     * @class MomentAccumulator\n
+     * Накапливает количество, сумму, минимум, максимум, среднее и центральные моменты M2, M3, M4\n
+     * онлайн (Welford / Terriberry), не храня саму выборку\n\n
+     * push(value) / push(data, size) - добавляет значения\n\n
+     * merge(other) - точно объединяет результаты, накопленные независимо\n
+     * (потоками, частями файла, разными партиями измерений) по формулам Pébay\n\n
+     * Copyable, moveable, final class
+     */
+    class MomentAccumulator final {
+    public:
+        using value_type = double;
+        using size_type = std::size_t;
+
+        /**
+         * @struct State
+         * Внутреннее состояние аккумулятора, по которому его можно сохранить и восстановить без пересчета
+         */
+        struct State {
+            size_type count {};
+            value_type sum {}, minimum {}, maximum {};
+            value_type mean {}, m2 {}, m3 {}, m4 {};
+        };
+
+    public:
+        MomentAccumulator() = default;
+        explicit MomentAccumulator(const State &state) noexcept
+            : MomentAccumulator(state.count, state.sum, state.minimum, state.maximum, state.mean, state.m2, state.m3, state.m4) {}
+
+    public:
+        void push(value_type value) noexcept {
+            if (!count_)
+                minimum_ = maximum_ = value;
+            else if (value < minimum_)
+                minimum_ = value;
+            else if (value > maximum_)
+                maximum_ = value;
+            sum_ += value;
+
+            value_type n1 = static_cast<value_type>(count_);
+            value_type n = static_cast<value_type>(++count_);
+            value_type delta = value - mean_;
+            value_type delta_n = delta / n;
+            value_type delta_n2 = delta_n * delta_n;
+            value_type term = delta * delta_n * n1;
+            mean_ += delta_n;
+            m4_ += term * delta_n2 * (n * n - 3 * n + 3) + 6 * delta_n2 * m2_ - 4 * delta_n * m3_;
+            m3_ += term * delta_n * (n - 2) - 3 * delta_n * m2_;
+            m2_ += term;
+        }
+
+        /**
+         * Значения обрабатываются блоками: сумма и центральные суммы блока считаются векторными ядрами simd,
+         * после чего блок объединяется с уже накопленным результатом через merge
+         */
+        void push(const value_type *data, size_type size) noexcept {
+            for (size_type offset = 0; offset < size; offset += kBlockSize) {
+                size_type block_size = std::min(kBlockSize, size - offset);
+                const value_type *block = data + offset;
+                value_type n = static_cast<value_type>(block_size);
+                value_type block_sum = simd::sum(block, block_size);
+                auto sums = simd::centralSums(block, block_size, block_sum / n);
+
+                // Поправка моментов на отличие block_sum / n от точного среднего блока
+                value_type shift = sums.d1 / n;
+                value_type m2 = sums.d2 - shift * sums.d1;
+                value_type m3 = sums.d3 - 3 * shift * sums.d2 + 2 * shift * shift * sums.d1;
+                value_type m4 = sums.d4 - 4 * shift * sums.d3 + 6 * shift * shift * sums.d2 - 3 * shift * shift * shift * sums.d1;
+                merge(MomentAccumulator(block_size, block_sum, sums.minimum, sums.maximum, block_sum / n + shift, m2, m3, m4));
+            }
+        }
+
+        void push(const std::vector<value_type> &values) noexcept { push(values.data(), values.size()); }
+
+        void merge(const MomentAccumulator &other) noexcept {
+            if (!other.count_)
+                return;
+            if (!count_) {
+                *this = other;
+                return;
+            }
+            value_type na = static_cast<value_type>(count_), nb = static_cast<value_type>(other.count_);
+            value_type n = na + nb;
+            value_type delta = other.mean_ - mean_;
+            value_type delta2 = delta * delta;
+
+            value_type m2 = m2_ + other.m2_ + delta2 * na * nb / n;
+            value_type m3 = m3_ + other.m3_ + delta * delta2 * na * nb * (na - nb) / (n * n)
+                            + 3 * delta * (na * other.m2_ - nb * m2_) / n;
+            value_type m4 = m4_ + other.m4_ + delta2 * delta2 * na * nb * (na * na - na * nb + nb * nb) / (n * n * n)
+                            + 6 * delta2 * (na * na * other.m2_ + nb * nb * m2_) / (n * n)
+                            + 4 * delta * (na * other.m3_ - nb * m3_) / n;
+
+            mean_ += delta * nb / n;
+            m2_ = m2, m3_ = m3, m4_ = m4;
+            count_ += other.count_;
+            sum_ += other.sum_;
+            if (other.minimum_ < minimum_)
+                minimum_ = other.minimum_;
+            if (other.maximum_ > maximum_)
+                maximum_ = other.maximum_;
+        }
+
+        void reset() noexcept { *this = MomentAccumulator{}; }
+
+        size_type count() const noexcept { return count_; }
+        value_type sum() const noexcept { return sum_; }
+        value_type minimum() const noexcept { return minimum_; }
+        value_type maximum() const noexcept { return maximum_; }
+        value_type mean() const noexcept { return mean_; }
+        value_type variance() const noexcept { return count_ ? m2_ / static_cast<value_type>(count_) : value_type{}; }
+        value_type deviation() const noexcept { return std::sqrt(variance()); }
+
+        value_type skewness() const noexcept {
+            if (m2_ <= 0)
+                return {};
+            return std::sqrt(static_cast<value_type>(count_)) * m3_ / std::pow(m2_, 1.5);
+        }
+
+        value_type kurtosis() const noexcept {
+            if (m2_ <= 0)
+                return {};
+            return static_cast<value_type>(count_) * m4_ / (m2_ * m2_) - 3;
+        }
+
+        State state() const noexcept { return State{count_, sum_, minimum_, maximum_, mean_, m2_, m3_, m4_}; }
+
+        StatisticSummary summary() const noexcept {
+            return StatisticSummary{count_, sum_, minimum_, maximum_, mean_, variance(), skewness(), kurtosis()};
+        }
+
+    private:
+        static constexpr size_type kBlockSize = 1024;
+
+        MomentAccumulator(size_type count, value_type sum, value_type minimum, value_type maximum,
+                          value_type mean, value_type m2, value_type m3, value_type m4) noexcept
+            : count_(count), sum_(sum), minimum_(minimum), maximum_(maximum), mean_(mean), m2_(m2), m3_(m3), m4_(m4) {}
+
+        size_type count_ {};
+        value_type sum_ {}, minimum_ {}, maximum_ {};
+        value_type mean_ {}, m2_ {}, m3_ {}, m4_ {};
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_MODEL_LABORATORYENGINE_MOMENT_ACCUMULATOR_H_
@@ -0,0 +1,318 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_MODEL_LABORATORYENGINE_SIMD_KERNELS_H_
+#define STATISTIC_ANALYZER_MODEL_LABORATORYENGINE_SIMD_KERNELS_H_
+
+#include <atomic>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define S21_SIMD_X86 1
+    #define S21_SIMD_TARGET(isa) __attribute__((target(isa)))
+    #include <immintrin.h>
+#endif
+
+namespace s21::simd {
+    /**
+     * @enum Isa
+     * Набор инструкций, которым выполняются редукции над выборкой
+     */
+    enum class Isa : int { kScalar, kSse2, kAvx2, kAvx512 };
+
+    /**
+     * @struct CentralSums
+     * Суммы степеней отклонений d = x - center (d, d^2, d^3, d^4) и минимум/максимум блока
+     */
+    struct CentralSums {
+        double d1 {}, d2 {}, d3 {}, d4 {};
+        double minimum {}, maximum {};
+    };
+
+    namespace detail {
+        inline double sumScalar(const double *data, std::size_t size) noexcept {
+            double result {};
+            for (std::size_t current = 0; current != size; ++current)
+                result += data[current];
+            return result;
+        }
+
+        inline void addTail(CentralSums &sums, const double *data, std::size_t from, std::size_t size, double center) noexcept {
+            for (std::size_t current = from; current < size; ++current) {
+                double value = data[current];
+                double d = value - center, d2 = d * d;
+                sums.d1 += d;
+                sums.d2 += d2;
+                sums.d3 += d2 * d;
+                sums.d4 += d2 * d2;
+                if (value < sums.minimum)
+                    sums.minimum = value;
+                if (value > sums.maximum)
+                    sums.maximum = value;
+            }
+        }
+
+        inline CentralSums centralSumsScalar(const double *data, std::size_t size, double center) noexcept {
+            CentralSums sums;
+            sums.minimum = sums.maximum = data[0];
+            addTail(sums, data, 0, size, center);
+            return sums;
+        }
+
+#ifdef S21_SIMD_X86
+        S21_SIMD_TARGET("sse2") inline double horizontal(__m128d value) noexcept {
+            double lanes[2];
+            _mm_storeu_pd(lanes, value);
+            return lanes[0] + lanes[1];
+        }
+
+        S21_SIMD_TARGET("sse2") inline double sumSse2(const double *data, std::size_t size) noexcept {
+            __m128d a0 = _mm_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+            std::size_t current = 0;
+            for (; current + 8 <= size; current += 8) {
+                a0 = _mm_add_pd(a0, _mm_loadu_pd(data + current));
+                a1 = _mm_add_pd(a1, _mm_loadu_pd(data + current + 2));
+                a2 = _mm_add_pd(a2, _mm_loadu_pd(data + current + 4));
+                a3 = _mm_add_pd(a3, _mm_loadu_pd(data + current + 6));
+            }
+            double result = horizontal(_mm_add_pd(_mm_add_pd(a0, a1), _mm_add_pd(a2, a3)));
+            for (; current != size; ++current)
+                result += data[current];
+            return result;
+        }
+
+        S21_SIMD_TARGET("sse2") inline CentralSums centralSumsSse2(const double *data, std::size_t size, double center) noexcept {
+            __m128d c = _mm_set1_pd(center);
+            __m128d s1 = _mm_setzero_pd(), s2 = s1, s3 = s1, s4 = s1;
+            __m128d mn = _mm_set1_pd(data[0]), mx = mn;
+            std::size_t current = 0;
+            for (; current + 2 <= size; current += 2) {
+                __m128d x = _mm_loadu_pd(data + current);
+                __m128d d = _mm_sub_pd(x, c), d2 = _mm_mul_pd(d, d);
+                s1 = _mm_add_pd(s1, d);
+                s2 = _mm_add_pd(s2, d2);
+                s3 = _mm_add_pd(s3, _mm_mul_pd(d2, d));
+                s4 = _mm_add_pd(s4, _mm_mul_pd(d2, d2));
+                mn = _mm_min_pd(mn, x);
+                mx = _mm_max_pd(mx, x);
+            }
+            double lanes_min[2], lanes_max[2];
+            _mm_storeu_pd(lanes_min, mn);
+            _mm_storeu_pd(lanes_max, mx);
+            CentralSums sums{horizontal(s1), horizontal(s2), horizontal(s3), horizontal(s4),
+                             lanes_min[0] < lanes_min[1] ? lanes_min[0] : lanes_min[1],
+                             lanes_max[0] > lanes_max[1] ? lanes_max[0] : lanes_max[1]};
+            addTail(sums, data, current, size, center);
+            return sums;
+        }
+
+        S21_SIMD_TARGET("avx2,fma") inline double horizontal(__m256d value) noexcept {
+            double lanes[4];
+            _mm256_storeu_pd(lanes, value);
+            return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        }
+
+        S21_SIMD_TARGET("avx2,fma") inline double sumAvx2(const double *data, std::size_t size) noexcept {
+            __m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+            std::size_t current = 0;
+            for (; current + 16 <= size; current += 16) {
+                a0 = _mm256_add_pd(a0, _mm256_loadu_pd(data + current));
+                a1 = _mm256_add_pd(a1, _mm256_loadu_pd(data + current + 4));
+                a2 = _mm256_add_pd(a2, _mm256_loadu_pd(data + current + 8));
+                a3 = _mm256_add_pd(a3, _mm256_loadu_pd(data + current + 12));
+            }
+            double result = horizontal(_mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3)));
+            for (; current != size; ++current)
+                result += data[current];
+            return result;
+        }
+
+        S21_SIMD_TARGET("avx2,fma") inline CentralSums centralSumsAvx2(const double *data, std::size_t size, double center) noexcept {
+            __m256d c = _mm256_set1_pd(center);
+            __m256d s1 = _mm256_setzero_pd(), s2 = s1, s3 = s1, s4 = s1;
+            __m256d mn = _mm256_set1_pd(data[0]), mx = mn;
+            std::size_t current = 0;
+            for (; current + 4 <= size; current += 4) {
+                __m256d x = _mm256_loadu_pd(data + current);
+                __m256d d = _mm256_sub_pd(x, c), d2 = _mm256_mul_pd(d, d);
+                s1 = _mm256_add_pd(s1, d);
+                s2 = _mm256_add_pd(s2, d2);
+                s3 = _mm256_fmadd_pd(d2, d, s3);
+                s4 = _mm256_fmadd_pd(d2, d2, s4);
+                mn = _mm256_min_pd(mn, x);
+                mx = _mm256_max_pd(mx, x);
+            }
+            double lanes_min[4], lanes_max[4];
+            _mm256_storeu_pd(lanes_min, mn);
+            _mm256_storeu_pd(lanes_max, mx);
+            CentralSums sums{horizontal(s1), horizontal(s2), horizontal(s3), horizontal(s4), lanes_min[0], lanes_max[0]};
+            for (int lane = 1; lane != 4; ++lane) {
+                if (lanes_min[lane] < sums.minimum)
+                    sums.minimum = lanes_min[lane];
+                if (lanes_max[lane] > sums.maximum)
+                    sums.maximum = lanes_max[lane];
+            }
+            addTail(sums, data, current, size, center);
+            return sums;
+        }
+
+        // Заголовки GCC 12 инициализируют _mm512_undefined_pd() самоприсваиванием, что дает ложные -Wuninitialized
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wuninitialized"
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+        S21_SIMD_TARGET("avx512f") inline double sumAvx512(const double *data, std::size_t size) noexcept {
+            __m512d a0 = _mm512_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+            std::size_t current = 0;
+            for (; current + 32 <= size; current += 32) {
+                a0 = _mm512_add_pd(a0, _mm512_loadu_pd(data + current));
+                a1 = _mm512_add_pd(a1, _mm512_loadu_pd(data + current + 8));
+                a2 = _mm512_add_pd(a2, _mm512_loadu_pd(data + current + 16));
+                a3 = _mm512_add_pd(a3, _mm512_loadu_pd(data + current + 24));
+            }
+            double result = _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(a0, a1), _mm512_add_pd(a2, a3)));
+            for (; current != size; ++current)
+                result += data[current];
+            return result;
+        }
+
+        S21_SIMD_TARGET("avx512f") inline CentralSums centralSumsAvx512(const double *data, std::size_t size, double center) noexcept {
+            __m512d c = _mm512_set1_pd(center);
+            __m512d s1 = _mm512_setzero_pd(), s2 = s1, s3 = s1, s4 = s1;
+            __m512d mn = _mm512_set1_pd(data[0]), mx = mn;
+            std::size_t current = 0;
+            for (; current + 8 <= size; current += 8) {
+                __m512d x = _mm512_loadu_pd(data + current);
+                __m512d d = _mm512_sub_pd(x, c), d2 = _mm512_mul_pd(d, d);
+                s1 = _mm512_add_pd(s1, d);
+                s2 = _mm512_add_pd(s2, d2);
+                s3 = _mm512_fmadd_pd(d2, d, s3);
+                s4 = _mm512_fmadd_pd(d2, d2, s4);
+                mn = _mm512_min_pd(mn, x);
+                mx = _mm512_max_pd(mx, x);
+            }
+            CentralSums sums{_mm512_reduce_add_pd(s1), _mm512_reduce_add_pd(s2),
+                             _mm512_reduce_add_pd(s3), _mm512_reduce_add_pd(s4),
+                             _mm512_reduce_min_pd(mn), _mm512_reduce_max_pd(mx)};
+            addTail(sums, data, current, size, center);
+            return sums;
+        }
+        #pragma GCC diagnostic pop
+#endif // S21_SIMD_X86
+
+        inline Isa detectIsa() noexcept {
+#ifdef S21_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+                return Isa::kAvx512;
+            if (__builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma"))
+                return Isa::kAvx2;
+            if (__builtin_cpu_supports("sse2"))
+                return Isa::kSse2;
+#endif
+            return Isa::kScalar;
+        }
+
+        /**
+         * Переменная окружения S21_SIMD_ISA=scalar|sse2|avx2|avx512 ограничивает набор инструкций сверху
+         */
+        inline Isa initialIsa() noexcept {
+            Isa detected = detectIsa();
+            const char *forced = std::getenv("S21_SIMD_ISA");
+            if (!forced)
+                return detected;
+            Isa requested = detected;
+            if (!std::strcmp(forced, "scalar"))
+                requested = Isa::kScalar;
+            else if (!std::strcmp(forced, "sse2"))
+                requested = Isa::kSse2;
+            else if (!std::strcmp(forced, "avx2"))
+                requested = Isa::kAvx2;
+            else if (!std::strcmp(forced, "avx512"))
+                requested = Isa::kAvx512;
+            return requested < detected ? requested : detected;
+        }
+
+        inline std::atomic<Isa> &activeIsaStorage() noexcept {
+            static std::atomic<Isa> isa{initialIsa()};
+            return isa;
+        }
+    }
+
+    /**
+     * @brief supportedIsa
+     * @return
+     * Наилучший набор инструкций, поддерживаемый процессором и ОС
+     */
+    inline Isa supportedIsa() noexcept {
+        static const Isa supported = detail::detectIsa();
+        return supported;
+    }
+
+    /**
+     * @brief activeIsa
+     * @return
+     * Набор инструкций, используемый ядрами в данный момент
+     */
+    inline Isa activeIsa() noexcept { return detail::activeIsaStorage().load(std::memory_order_relaxed); }
+
+    /**
+     * @brief forceIsa
+     * Принудительно выбирает набор инструкций (для тестирования), не выше поддерживаемого процессором
+     */
+    inline void forceIsa(Isa isa) noexcept {
+        Isa supported = supportedIsa();
+        detail::activeIsaStorage().store(isa < supported ? isa : supported, std::memory_order_relaxed);
+    }
+
+    inline const char *isaName(Isa isa) noexcept {
+        switch (isa) {
+            case Isa::kSse2: return "sse2";
+            case Isa::kAvx2: return "avx2";
+            case Isa::kAvx512: return "avx512";
+            default: return "scalar";
+        }
+    }
+
+    /**
+     * @brief sum
+     * @return
+     * Сумма size значений, начиная с data
+     */
+    inline double sum(const double *data, std::size_t size) noexcept {
+        switch (activeIsa()) {
+#ifdef S21_SIMD_X86
+            case Isa::kAvx512: return detail::sumAvx512(data, size);
+            case Isa::kAvx2: return detail::sumAvx2(data, size);
+            case Isa::kSse2: return detail::sumSse2(data, size);
+#endif
+            default: return detail::sumScalar(data, size);
+        }
+    }
+
+    /**
+     * @brief centralSums
+     * Суммы степеней отклонений от center и минимум/максимум за один проход, size > 0
+     */
+    inline CentralSums centralSums(const double *data, std::size_t size, double center) noexcept {
+        switch (activeIsa()) {
+#ifdef S21_SIMD_X86
+            case Isa::kAvx512: return detail::centralSumsAvx512(data, size, center);
+            case Isa::kAvx2: return detail::centralSumsAvx2(data, size, center);
+            case Isa::kSse2: return detail::centralSumsSse2(data, size, center);
+#endif
+            default: return detail::centralSumsScalar(data, size, center);
+        }
+    }
+}
+
+#endif // !STATISTIC_ANALYZER_MODEL_LABORATORYENGINE_SIMD_KERNELS_H_
@@ -0,0 +1,83 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_MODEL_LABORATORYENGINE_STATISTIC_HISTOGRAM_H_
+#define STATISTIC_ANALYZER_MODEL_LABORATORYENGINE_STATISTIC_HISTOGRAM_H_
+
+#include <vector>
+#include <cstddef>
+
+namespace s21 {
+    /**
+     * @class StatisticHistogram\n
+     * Гистограмма с binsCount() равными корзинами на отрезке [minimum, maximum], заданном заранее\n
+     * Значения добавляются push(value) / push(data, size) без хранения самой выборки,\n
+     * поэтому гистограмму можно строить по частям (например, из NormalDistributionStatisticReader::stream)\n\n
+     * Корзина bin - [lower(bin), lower(bin + 1)), последняя корзина включает maximum\n
+     * Значения вне отрезка и NaN не попадают в корзины и считаются в outside()\n\n
+     * Copyable, moveable, final class
+     */
+    class StatisticHistogram final {
+    public:
+        using value_type = double;
+        using size_type = std::size_t;
+
+    public:
+        StatisticHistogram() = default;
+        StatisticHistogram(value_type minimum, value_type maximum, size_type bins_count)
+            : minimum_(minimum), maximum_(maximum), counts_(bins_count ? bins_count : 1) {
+            value_type width = (maximum_ - minimum_) / static_cast<value_type>(counts_.size());
+            scale_ = width > 0 ? 1 / width : 0;
+        }
+
+    public:
+        void push(value_type value) noexcept {
+            if (!(value >= minimum_ and value <= maximum_)) {
+                ++outside_;
+                return;
+            }
+            size_type bin = static_cast<size_type>((value - minimum_) * scale_);
+            ++counts_[bin < counts_.size() ? bin : counts_.size() - 1];
+        }
+
+        void push(const value_type *data, size_type size) noexcept {
+            for (size_type current = 0; current != size; ++current)
+                push(data[current]);
+        }
+
+        void push(const std::vector<value_type> &values) noexcept { push(values.data(), values.size()); }
+
+        /**
+         * Объединяет гистограммы с одинаковыми границами и количеством корзин
+         */
+        void merge(const StatisticHistogram &other) noexcept {
+            for (size_type bin = 0, size = counts_.size(); bin != size and bin != other.counts_.size(); ++bin)
+                counts_[bin] += other.counts_[bin];
+            outside_ += other.outside_;
+        }
+
+        size_type binsCount() const noexcept { return counts_.size(); }
+        const std::vector<size_type> &counts() const noexcept { return counts_; }
+        size_type count(size_type bin) const noexcept { return counts_[bin]; }
+        size_type outside() const noexcept { return outside_; }
+        value_type minimum() const noexcept { return minimum_; }
+        value_type maximum() const noexcept { return maximum_; }
+        value_type binWidth() const noexcept { return (maximum_ - minimum_) / static_cast<value_type>(counts_.size()); }
+        value_type lower(size_type bin) const noexcept { return minimum_ + binWidth() * static_cast<value_type>(bin); }
+
+    private:
+        value_type minimum_ {}, maximum_ {}, scale_ {};
+        std::vector<size_type> counts_ = std::vector<size_type>(1);
+        size_type outside_ {};
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_MODEL_LABORATORYENGINE_STATISTIC_HISTOGRAM_H_
@@ -0,0 +1,291 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_MODEL_LABORATORYENGINE_STATISTIC_SORTER_H_
+#define STATISTIC_ANALYZER_MODEL_LABORATORYENGINE_STATISTIC_SORTER_H_
+
+#include <cmath>
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include "../ThreadPool/thread_pool.h"
+
+namespace s21 {
+    /**
+     * @brief statisticLess
+     * Строгий порядок значений выборки, общий для всех способов сортировки:\n
+     * -0.0 идет перед +0.0, все NaN считаются равными между собой и идут в конце
+     */
+    inline bool statisticLess(double lhs, double rhs) noexcept {
+        if (lhs < rhs)
+            return true;
+        if (rhs < lhs)
+            return false;
+        bool lhs_nan = std::isnan(lhs), rhs_nan = std::isnan(rhs);
+        if (lhs_nan or rhs_nan)
+            return !lhs_nan and rhs_nan;
+        return std::signbit(lhs) and !std::signbit(rhs);
+    }
+
+    /**
+     * @class StatisticSorter\n
+     * Сортирует выборку по возрастанию в порядке statisticLess\n\n
+     * Backend::kSerial - std::sort\n\n
+     * Backend::kParallel - параллельная сортировка слиянием на ThreadPool::shared():\n
+     * выборка делится на threadsCount() частей, части сортируются std::sort параллельно,\n
+     * затем попарно сливаются, каждое слияние тоже делится между потоками\n\n
+     * Backend::kRadix - LSD поразрядная сортировка по 11 бит над ключами, полученными\n
+     * сохраняющим порядок преобразованием битов IEEE-754, время линейно по размеру выборки\n\n
+     * Выборки короче parallelThreshold() всегда сортируются последовательно (kParallel)\n\n
+     * ScratchPolicy управляет буферами: kKeep оставляет их между сортировками, kRelease освобождает\n\n
+     * Результат всех backend'ов совпадает поэлементно
+     */
+    class StatisticSorter final {
+    public:
+        using statistic_type = std::vector<double>;
+        using statistic_value_type = statistic_type::value_type;
+        using statistic_size_type = statistic_type::size_type;
+
+        enum class Backend { kSerial, kParallel, kRadix };
+        enum class ScratchPolicy { kKeep, kRelease };
+
+    public:
+        void backend(Backend backend) noexcept { backend_ = backend; }
+        void threadsCount(statistic_size_type threads_count) noexcept { threads_count_ = threads_count; }
+        void parallelThreshold(statistic_size_type threshold) noexcept { parallel_threshold_ = threshold; }
+        void scratchPolicy(ScratchPolicy policy) noexcept { scratch_policy_ = policy; }
+
+        Backend backend() const noexcept { return backend_; }
+        statistic_size_type threadsCount() const noexcept { return threads_count_ ? threads_count_ : ThreadPool::defaultThreadsCount(); }
+        statistic_size_type parallelThreshold() const noexcept { return parallel_threshold_; }
+        ScratchPolicy scratchPolicy() const noexcept { return scratch_policy_; }
+
+        static constexpr std::array<Backend, 3> kBackends = {Backend::kSerial, Backend::kParallel, Backend::kRadix};
+
+        static const char *backendName(Backend backend) noexcept {
+            switch (backend) {
+                case Backend::kSerial:   return "serial";
+                case Backend::kParallel: return "parallel";
+                case Backend::kRadix:    return "radix";
+            }
+            return "";
+        }
+
+        static bool parseBackend(const std::string &name, Backend &backend) noexcept {
+            for (auto candidate : kBackends) {
+                if (name == backendName(candidate)) {
+                    backend = candidate;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * NaN переносятся в конец с сохранением порядка, остальные значения сортируются обычным сравнением <,\n
+         * после чего среди нулей -0.0 ставятся перед +0.0 - итог совпадает с std::sort(..., statisticLess)
+         */
+        void sort(statistic_type &statistic) {
+            statistic_size_type size = moveNanToEnd(statistic);
+            if (backend_ == Backend::kRadix) {
+                sortRadix(statistic, size);
+            } else {
+                if (backend_ == Backend::kParallel and size >= parallel_threshold_ and threadsCount() > 1)
+                    sortParallel(statistic, size);
+                else
+                    std::sort(statistic.begin(), statistic.begin() + size);
+                auto [zeros_begin, zeros_end] = std::equal_range(statistic.begin(), statistic.begin() + size, 0.0);
+                std::partition(zeros_begin, zeros_end, [](statistic_value_type value) { return std::signbit(value); });
+            }
+            if (scratch_policy_ == ScratchPolicy::kRelease) {
+                statistic_type().swap(buffer_);
+                std::vector<std::uint64_t>().swap(radix_buffer_);
+            }
+        }
+
+    private:
+        Backend backend_ = Backend::kParallel;
+        statistic_size_type threads_count_ {}; // 0 - по количеству ядер
+        statistic_size_type parallel_threshold_ = 1 << 20;
+        ScratchPolicy scratch_policy_ = ScratchPolicy::kKeep;
+        statistic_type buffer_; // Буфер слияния, переиспользуется между сортировками
+        std::vector<std::uint64_t> radix_buffer_; // Буфер поразрядной сортировки
+
+        static constexpr unsigned kRadixBits = 11;
+        static constexpr unsigned kRadixPasses = (64 + kRadixBits - 1) / kRadixBits;
+        static constexpr std::size_t kRadixBuckets = std::size_t{1} << kRadixBits;
+
+    private:
+        /**
+         * @return
+         * Количество значений, не являющихся NaN; они остаются в начале выборки
+         */
+        static statistic_size_type moveNanToEnd(statistic_type &statistic) {
+            statistic_type nans;
+            statistic_size_type size = 0;
+            for (auto value : statistic) {
+                if (std::isnan(value))
+                    nans.push_back(value);
+                else
+                    statistic[size++] = value;
+            }
+            std::copy(nans.begin(), nans.end(), statistic.begin() + size);
+            return size;
+        }
+
+        void sortParallel(statistic_type &statistic, statistic_size_type size) {
+            auto &pool = ThreadPool::shared();
+            statistic_size_type threads = threadsCount();
+
+            std::vector<statistic_size_type> runs(threads + 1);
+            for (statistic_size_type run = 0; run <= threads; ++run)
+                runs[run] = size * run / threads;
+
+            statistic_value_type *source = statistic.data();
+            pool.parallelFor(threads, [&](statistic_size_type run) {
+                std::sort(source + runs[run], source + runs[run + 1]);
+            });
+
+            buffer_.resize(statistic.size());
+            statistic_value_type *destination = buffer_.data();
+            while (runs.size() > 2) {
+                statistic_size_type pairs = (runs.size() - 1) / 2;
+                statistic_size_type parts = std::max<statistic_size_type>(1, threads / pairs);
+                pool.parallelFor(pairs * parts, [&](statistic_size_type task) {
+                    statistic_size_type pair = task / parts;
+                    mergePart(source, destination, runs[2 * pair], runs[2 * pair + 1], runs[2 * pair + 2], task % parts, parts);
+                });
+                if ((runs.size() - 1) % 2) // Непарная последняя часть переносится как есть
+                    std::copy(source + runs[runs.size() - 2], source + size, destination + runs[runs.size() - 2]);
+
+                std::vector<statistic_size_type> merged;
+                for (statistic_size_type run = 0; run < runs.size(); run += 2)
+                    merged.push_back(runs[run]);
+                if (merged.back() != size)
+                    merged.push_back(size);
+                runs = std::move(merged);
+                std::swap(source, destination);
+            }
+            if (source != statistic.data()) {
+                std::copy(statistic.begin() + size, statistic.end(), buffer_.begin() + size); // NaN хвост
+                statistic.swap(buffer_);
+            }
+        }
+
+        /**
+         * Отрицательные числа инвертируются целиком, у положительных выставляется знаковый бит -\n
+         * после этого беззнаковое сравнение ключей совпадает с statisticLess (-0.0 < +0.0)
+         */
+        static std::uint64_t toRadixKey(statistic_value_type value) noexcept {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return (bits >> 63) ? ~bits : bits | (std::uint64_t{1} << 63);
+        }
+
+        static statistic_value_type fromRadixKey(std::uint64_t key) noexcept {
+            std::uint64_t bits = (key >> 63) ? key & ~(std::uint64_t{1} << 63) : ~key;
+            statistic_value_type value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        /**
+         * Ключи хранятся прямо в памяти выборки (через memcpy), второй буфер - radix_buffer_\n
+         * Гистограммы всех разрядов строятся за один проход, разряды с единственной корзиной пропускаются
+         */
+        void sortRadix(statistic_type &statistic, statistic_size_type size) {
+            if (size < 2)
+                return;
+            std::vector<std::array<statistic_size_type, kRadixBuckets>> histograms(kRadixPasses);
+            for (auto &histogram : histograms)
+                histogram.fill(0);
+
+            statistic_value_type *values = statistic.data();
+            for (statistic_size_type current = 0; current != size; ++current) {
+                std::uint64_t key = toRadixKey(values[current]);
+                std::memcpy(values + current, &key, sizeof(key));
+                for (unsigned pass = 0; pass != kRadixPasses; ++pass)
+                    ++histograms[pass][(key >> (pass * kRadixBits)) & (kRadixBuckets - 1)];
+            }
+
+            if (radix_buffer_.size() < size)
+                radix_buffer_.resize(size);
+            unsigned char *source = reinterpret_cast<unsigned char *>(values);
+            unsigned char *destination = reinterpret_cast<unsigned char *>(radix_buffer_.data());
+            for (unsigned pass = 0; pass != kRadixPasses; ++pass) {
+                auto &histogram = histograms[pass];
+                std::uint64_t first_key;
+                std::memcpy(&first_key, source, sizeof(first_key));
+                if (histogram[(first_key >> (pass * kRadixBits)) & (kRadixBuckets - 1)] == size)
+                    continue;
+
+                statistic_size_type offset = 0;
+                for (auto &bucket : histogram) {
+                    statistic_size_type count = bucket;
+                    bucket = offset;
+                    offset += count;
+                }
+                for (statistic_size_type current = 0; current != size; ++current) {
+                    std::uint64_t key;
+                    std::memcpy(&key, source + current * sizeof(key), sizeof(key));
+                    std::memcpy(destination + histogram[(key >> (pass * kRadixBits)) & (kRadixBuckets - 1)]++ * sizeof(key), &key, sizeof(key));
+                }
+                std::swap(source, destination);
+            }
+            if (source != reinterpret_cast<unsigned char *>(values))
+                std::memcpy(values, source, size * sizeof(std::uint64_t));
+
+            for (statistic_size_type current = 0; current != size; ++current) {
+                std::uint64_t key;
+                std::memcpy(&key, values + current, sizeof(key));
+                values[current] = fromRadixKey(key);
+            }
+        }
+
+        /**
+         * Сливает часть part из parts runs [first, middle) и [middle, last) в destination\n
+         * Разрез делается по более длинной последовательности, позиция в другой ищется бинарным поиском так,\n
+         * чтобы равные элементы шли в том же порядке, что и при std::merge
+         */
+        static void mergePart(const statistic_value_type *source, statistic_value_type *destination,
+                              statistic_size_type first, statistic_size_type middle, statistic_size_type last,
+                              statistic_size_type part, statistic_size_type parts) {
+            const statistic_value_type *a = source + first, *b = source + middle;
+            statistic_size_type a_size = middle - first, b_size = last - middle;
+            parts = std::min(parts, std::max(a_size, b_size));
+            if (part >= parts)
+                return;
+
+            auto split = [&](statistic_size_type index) -> std::pair<statistic_size_type, statistic_size_type> {
+                if (!index)
+                    return {0, 0};
+                if (index == parts)
+                    return {a_size, b_size};
+                if (a_size >= b_size) {
+                    statistic_size_type a_split = a_size * index / parts;
+                    return {a_split, static_cast<statistic_size_type>(std::lower_bound(b, b + b_size, a[a_split]) - b)};
+                }
+                statistic_size_type b_split = b_size * index / parts;
+                return {static_cast<statistic_size_type>(std::upper_bound(a, a + a_size, b[b_split]) - a), b_split};
+            };
+
+            auto [a_begin, b_begin] = split(part);
+            auto [a_end, b_end] = split(part + 1);
+            std::merge(a + a_begin, a + a_end, b + b_begin, b + b_end, destination + first + a_begin + b_begin);
+        }
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_MODEL_LABORATORYENGINE_STATISTIC_SORTER_H_
@@ -0,0 +1,67 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_MODEL_PROFILER_ALLOCATION_COUNTER_H_
+#define STATISTIC_ANALYZER_MODEL_PROFILER_ALLOCATION_COUNTER_H_
+
+/**
+ * Заменяет глобальные operator new / operator delete, чтобы StageProfile считал выделения памяти по стадиям\n
+ * Включается ровно в одну единицу трансляции программы (в ее main.cpp), при S21_NO_PROFILING ничего не заменяет\n
+ * Выделение считается одним инкрементом thread_local счетчика и только в потоке с активным профилем,\n
+ * без ProfileSession замена стоит одного чтения thread_local указателя\n
+ * Считаются выделения кода программы: библиотеки со своим распределителем (Qt DLL под Windows) не учитываются\n
+ * Массивы и nothrow-варианты стандартная библиотека выделяет через operator new(size_t)
+ */
+
+#include "stage_profiler.h"
+
+#if !defined(S21_NO_PROFILING)
+
+#include <new>
+#include <cstdlib>
+
+namespace s21 {
+    namespace {
+        const bool kAllocationCounterInstalled = (AllocationCounter::installed = true);
+    }
+}
+
+void *operator new(std::size_t size) {
+    if (s21::StageProfile::current())
+        ++s21::AllocationCounter::allocations;
+    if (!size)
+        size = 1;
+    for (;;) { // Как стандартный operator new: new_handler может освободить память и дать выделению повториться
+        if (void *pointer = std::malloc(size))
+            return pointer;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+// GCC, встроив delete в вызывающий код, считает free() несовместимым с operator new, хотя тот выделяет через malloc()
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept { std::free(pointer); }
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#  pragma GCC diagnostic pop
+#endif
+
+#endif // !S21_NO_PROFILING
+
+#endif // !STATISTIC_ANALYZER_MODEL_PROFILER_ALLOCATION_COUNTER_H_
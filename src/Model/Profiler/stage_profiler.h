@@ -0,0 +1,303 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_MODEL_PROFILER_STAGE_PROFILER_H_
+#define STATISTIC_ANALYZER_MODEL_PROFILER_STAGE_PROFILER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+
+namespace s21 {
+    /**
+     * @struct AllocationCounter
+     * Количество вызовов operator new текущим потоком, пока в нем активен профиль (ProfileSession)\n
+     * Выделения задач ThreadPool не считаются: у рабочих потоков нет активного профиля\n
+     * Считается, только если в программу включен allocation_counter.h (installed == true)
+     */
+    struct AllocationCounter {
+        static inline thread_local std::size_t allocations = 0;
+        static inline std::atomic<bool> installed {false};
+    };
+
+    /**
+     * @struct StageRecord
+     * Стадия обработки: суммарное время всех вызовов, количество обработанных элементов и выделений памяти\n
+     * parent - индекс объемлющей стадии (StageProfile::npos у внешних), depth - глубина вложенности
+     */
+    struct StageRecord {
+        std::string name;
+        std::size_t parent {};
+        std::size_t depth {};
+        std::size_t calls {};
+        std::int64_t nanoseconds {};
+        std::size_t elements {};
+        std::size_t allocations {};
+
+        double milliseconds() const noexcept { return static_cast<double>(nanoseconds) / 1e6; }
+    };
+
+    /**
+     * @class StageProfile\n
+     * Разбивка последнего действия по стадиям, которые отмечены S21_PROFILE_SCOPE\n\n
+     * Стадии записываются в профиль, активный в текущем потоке (ProfileSession), без активного профиля\n
+     * S21_PROFILE_SCOPE стоит одного чтения thread_local указателя, при S21_NO_PROFILING макросы пусты\n
+     * Повторные вызовы стадии внутри той же объемлющей стадии складываются в одну запись (calls)\n
+     * Стадии, начатые в задачах ThreadPool, не записываются: у рабочих потоков нет активного профиля\n\n
+     * Copyable, moveable, final class
+     */
+    class StageProfile final {
+    public:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    public:
+        /**
+         * Включение профилирования во время работы: выключенное не дает ProfileSession активировать профиль
+         */
+        static void enabled(bool enabled) noexcept { enabled_.store(enabled, std::memory_order_relaxed); }
+        static bool enabled() noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+        static StageProfile *current() noexcept { return current_; }
+
+        /**
+         * @brief count
+         * Добавляет elements к самой внутренней незавершенной стадии активного профиля
+         */
+        static void count(std::size_t elements) noexcept {
+            if (current_ and current_->open_ != npos)
+                current_->stages_[current_->open_].elements += elements;
+        }
+
+        const std::vector<StageRecord> &stages() const noexcept { return stages_; }
+        bool empty() const noexcept { return stages_.empty(); }
+
+        void clear() noexcept {
+            stages_.clear();
+            open_ = npos;
+        }
+
+        /**
+         * Суммарное время внешних стадий
+         */
+        std::int64_t nanoseconds() const noexcept {
+            std::int64_t total = 0;
+            for (const auto &stage : stages_)
+                if (stage.parent == npos)
+                    total += stage.nanoseconds;
+            return total;
+        }
+
+        /**
+         * Имя стадии вместе с объемлющими: "read/parse"
+         */
+        std::string path(std::size_t index) const {
+            std::string result = stages_[index].name;
+            for (std::size_t parent = stages_[index].parent; parent != npos; parent = stages_[parent].parent)
+                result = stages_[parent].name + '/' + result;
+            return result;
+        }
+
+        /**
+         * @brief merge
+         * Складывает стадии other с одноименными стадиями этого профиля (например, профили файлов пакета)
+         */
+        void merge(const StageProfile &other) {
+            std::vector<std::size_t> indices(other.stages_.size());
+            for (std::size_t index = 0; index != other.stages_.size(); ++index) {
+                const auto &stage = other.stages_[index];
+                std::size_t parent = stage.parent == npos ? npos : indices[stage.parent];
+                std::size_t target = find(stage.name, parent);
+                if (target == npos) {
+                    target = stages_.size();
+                    stages_.push_back(StageRecord{stage.name, parent, stage.depth, 0, 0, 0, 0});
+                }
+                stages_[target].calls += stage.calls;
+                stages_[target].nanoseconds += stage.nanoseconds;
+                stages_[target].elements += stage.elements;
+                stages_[target].allocations += stage.allocations;
+                indices[index] = target;
+            }
+        }
+
+        /**
+         * @brief summary
+         * Внешние стадии одной строкой: "read 12.3 ms, sort 4.5 ms"
+         */
+        std::string summary() const {
+            std::string text;
+            for (const auto &stage : stages_) {
+                if (stage.parent != npos)
+                    continue;
+                char buffer[64];
+                std::snprintf(buffer, sizeof(buffer), " %.1f ms", stage.milliseconds());
+                text += (text.empty() ? "" : ", ") + stage.name + buffer;
+            }
+            return text;
+        }
+
+        /**
+         * @brief report
+         * Таблица стадий с отступами по вложенности: время, вызовы, элементы, нс/элемент и выделения памяти\n
+         * Вложенные стадии идут сразу после своей объемлющей
+         */
+        void report(std::ostream &out) const {
+            char line[256];
+            std::snprintf(line, sizeof(line), "%-28s %12s %6s %12s %10s %10s\n", "stage", "ms", "calls", "elements", "ns/elem",
+                          AllocationCounter::installed ? "allocs" : "");
+            out << line;
+            for (std::size_t index = 0; index != stages_.size(); ++index)
+                if (stages_[index].parent == npos)
+                    reportStage(out, index);
+        }
+
+        /**
+         * Используются StageTimer: открывает стадию name внутри текущей незавершенной стадии
+         * @return
+         * Индекс записи стадии
+         */
+        std::size_t enter(const char *name) {
+            std::size_t index = find(name, open_);
+            if (index == npos) {
+                index = stages_.size();
+                std::size_t depth = open_ == npos ? 0 : stages_[open_].depth + 1;
+                stages_.push_back(StageRecord{name, open_, depth, 0, 0, 0, 0});
+            }
+            open_ = index;
+            return index;
+        }
+
+        void leave(std::size_t index, std::int64_t nanoseconds, std::size_t allocations) noexcept {
+            auto &stage = stages_[index];
+            ++stage.calls;
+            stage.nanoseconds += nanoseconds;
+            stage.allocations += allocations;
+            open_ = stage.parent;
+        }
+
+    private:
+        std::vector<StageRecord> stages_;
+        std::size_t open_ = npos;
+
+        static inline thread_local StageProfile *current_ = nullptr;
+        static inline std::atomic<bool> enabled_ {true};
+
+        friend class ProfileSession;
+
+    private:
+        std::size_t find(const std::string &name, std::size_t parent) const noexcept {
+            for (std::size_t index = 0; index != stages_.size(); ++index)
+                if (stages_[index].parent == parent and stages_[index].name == name)
+                    return index;
+            return npos;
+        }
+
+        void reportStage(std::ostream &out, std::size_t index) const {
+            const auto &stage = stages_[index];
+            std::string name = std::string(2 * stage.depth, ' ') + stage.name;
+            char elements[32] = "", per_element[32] = "", allocations[32] = "";
+            if (stage.elements) {
+                std::snprintf(elements, sizeof(elements), "%zu", stage.elements);
+                std::snprintf(per_element, sizeof(per_element), "%.2f", static_cast<double>(stage.nanoseconds) / static_cast<double>(stage.elements));
+            }
+            if (AllocationCounter::installed)
+                std::snprintf(allocations, sizeof(allocations), "%zu", stage.allocations);
+            char line[256];
+            std::snprintf(line, sizeof(line), "%-28s %12.3f %6zu %12s %10s %10s\n", name.c_str(), stage.milliseconds(), stage.calls,
+                          elements, per_element, allocations);
+            out << line;
+            for (std::size_t child = index + 1; child < stages_.size(); ++child)
+                if (stages_[child].parent == index)
+                    reportStage(out, child);
+        }
+    };
+
+    /**
+     * @class ProfileSession\n
+     * Делает profile активным в текущем потоке на время своей жизни и очищает его\n
+     * Вложенная сессия того же профиля ничего не меняет: действие, вызванное из другого действия,\n
+     * дописывает свои стадии в общий профиль\n\n
+     * Non-copyable, non-moveable, final class
+     */
+    class ProfileSession final {
+    public:
+        explicit ProfileSession(StageProfile &profile, bool active = true) noexcept : previous_(StageProfile::current_) {
+            if (!active or !StageProfile::enabled() or previous_ == &profile)
+                return;
+            profile.clear();
+            StageProfile::current_ = &profile;
+        }
+
+        ProfileSession(const ProfileSession &) = delete;
+        ProfileSession(ProfileSession &&) = delete;
+        ProfileSession &operator=(const ProfileSession &) = delete;
+        ProfileSession &operator=(ProfileSession &&) = delete;
+
+        ~ProfileSession() { StageProfile::current_ = previous_; }
+
+    private:
+        StageProfile *previous_;
+    };
+
+    /**
+     * @class StageTimer\n
+     * Стадия от конструктора до деструктора, используется через S21_PROFILE_SCOPE(name)\n
+     * name должна жить дольше таймера (строковый литерал)\n\n
+     * Non-copyable, non-moveable, final class
+     */
+    class StageTimer final {
+    public:
+        explicit StageTimer(const char *name) : profile_(StageProfile::current()) {
+            if (!profile_)
+                return;
+            index_ = profile_->enter(name);
+            allocations_ = AllocationCounter::allocations;
+            start_ = std::chrono::steady_clock::now();
+        }
+
+        StageTimer(const StageTimer &) = delete;
+        StageTimer(StageTimer &&) = delete;
+        StageTimer &operator=(const StageTimer &) = delete;
+        StageTimer &operator=(StageTimer &&) = delete;
+
+        ~StageTimer() {
+            if (!profile_)
+                return;
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+            profile_->leave(index_, elapsed, AllocationCounter::allocations - allocations_);
+        }
+
+    private:
+        StageProfile *profile_;
+        std::size_t index_ {};
+        std::size_t allocations_ {};
+        std::chrono::steady_clock::time_point start_ {};
+    };
+}
+
+/**
+ * S21_PROFILE_SCOPE(name) - стадия name до конца текущего блока\n
+ * S21_PROFILE_COUNT(elements) - элементы, обработанные текущей стадией (выражение при S21_NO_PROFILING не вычисляется)
+ */
+#if defined(S21_NO_PROFILING)
+#  define S21_PROFILE_SCOPE(name) ((void)0)
+#  define S21_PROFILE_COUNT(elements) ((void)0)
+#else
+#  define S21_PROFILE_CONCAT_IMPL(left, right) left##right
+#  define S21_PROFILE_CONCAT(left, right) S21_PROFILE_CONCAT_IMPL(left, right)
+#  define S21_PROFILE_SCOPE(name) ::s21::StageTimer S21_PROFILE_CONCAT(s21_stage_timer_, __LINE__)(name)
+#  define S21_PROFILE_COUNT(elements) ::s21::StageProfile::count(elements)
+#endif
+
+#endif // !STATISTIC_ANALYZER_MODEL_PROFILER_STAGE_PROFILER_H_
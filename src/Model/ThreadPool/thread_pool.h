@@ -0,0 +1,182 @@
+/** Statistic analyzer header file
+ *
+ * Copyright (C) Gubaydullin Nurislam, School 21. All Rights Reserved
+ *
+ * If the code of this project has helped you in any way,
+ * please thank me with a cup of beer.
+ *
+ * gmail:    gubaydullin.nurislam@gmail.com
+ * telegram: @tonitaga
+ */
+
+#ifndef STATISTIC_ANALYZER_MODEL_THREADPOOL_THREAD_POOL_H_
+#define STATISTIC_ANALYZER_MODEL_THREADPOOL_THREAD_POOL_H_
+
+#include <mutex>
+#include <queue>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace s21 {
+    /**
+     * @class ThreadPool\n
+     * Пул рабочих потоков с общей очередью задач\n\n
+     * submit(task) - ставит задачу в очередь, возвращает std::future с ее результатом\n\n
+     * parallelFor(count, function) - выполняет function(0..count-1) параллельно и дожидается завершения,\n
+     * ожидающий поток сам выполняет задачи из очереди, поэтому вложенный parallelFor не блокирует пул\n\n
+     * shared() - общий для всего приложения пул на std::thread::hardware_concurrency() потоков\n\n
+     * Non-copyable, non-moveable, final class
+     */
+    class ThreadPool final {
+    public:
+        using size_type = std::size_t;
+
+    public:
+        explicit ThreadPool(size_type threads_count = defaultThreadsCount()) {
+            if (!threads_count)
+                threads_count = 1;
+            workers_.reserve(threads_count);
+            for (size_type worker = 0; worker != threads_count; ++worker)
+                workers_.emplace_back([this] { workerLoop(); });
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool(ThreadPool &&) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+        ThreadPool &operator=(ThreadPool &&) = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopped_ = true;
+            }
+            condition_.notify_all();
+            for (auto &worker : workers_)
+                worker.join();
+        }
+
+    public:
+        static ThreadPool &shared() {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        static size_type defaultThreadsCount() noexcept {
+            size_type hardware = std::thread::hardware_concurrency();
+            return hardware ? hardware : 1;
+        }
+
+        size_type threadsCount() const noexcept { return workers_.size(); }
+
+        template <typename Function>
+        auto submit(Function function) -> std::future<decltype(function())> {
+            using result_type = decltype(function());
+            auto task = std::make_shared<std::packaged_task<result_type()>>(std::move(function));
+            auto result = task->get_future();
+            enqueue([task] { (*task)(); });
+            return result;
+        }
+
+        /**
+         * @brief parallelFor
+         * Выполняет function(index) для index из [0, count) на потоках пула и вызывающем потоке\n
+         * Первое выброшенное исключение пробрасывается вызывающему после завершения всех задач
+         */
+        template <typename Function>
+        void parallelFor(size_type count, Function function) {
+            if (!count)
+                return;
+            struct Latch {
+                std::mutex mutex;
+                std::condition_variable condition;
+                size_type remaining;
+                std::exception_ptr exception;
+            } latch;
+            latch.remaining = count;
+
+            auto run = [&latch, &function](size_type index) {
+                std::exception_ptr exception;
+                try {
+                    function(index);
+                } catch (...) {
+                    exception = std::current_exception();
+                }
+                std::lock_guard<std::mutex> lock(latch.mutex);
+                if (exception and !latch.exception)
+                    latch.exception = exception;
+                if (!--latch.remaining)
+                    latch.condition.notify_all();
+            };
+
+            for (size_type index = 1; index < count; ++index)
+                enqueue([&run, index] { run(index); });
+            run(0);
+
+            while (true) {
+                {
+                    std::lock_guard<std::mutex> lock(latch.mutex);
+                    if (!latch.remaining)
+                        break;
+                }
+                if (runPendingTask())
+                    continue;
+                std::unique_lock<std::mutex> lock(latch.mutex);
+                latch.condition.wait_for(lock, std::chrono::milliseconds(1), [&latch] { return !latch.remaining; });
+            }
+            if (latch.exception)
+                std::rethrow_exception(latch.exception);
+        }
+
+    private:
+        std::vector<std::thread> workers_;
+        std::queue<std::function<void()>> tasks_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        bool stopped_ = false;
+
+    private:
+        void enqueue(std::function<void()> task) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                tasks_.push(std::move(task));
+            }
+            condition_.notify_one();
+        }
+
+        bool runPendingTask() {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (tasks_.empty())
+                    return false;
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+            return true;
+        }
+
+        void workerLoop() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    condition_.wait(lock, [this] { return stopped_ or !tasks_.empty(); });
+                    if (stopped_ and tasks_.empty())
+                        return;
+                    task = std::move(tasks_.front());
+                    tasks_.pop();
+                }
+                task();
+            }
+        }
+    };
+}
+
+#endif // !STATISTIC_ANALYZER_MODEL_THREADPOOL_THREAD_POOL_H_
@@ -13,7 +13,10 @@
 #define STATISTIC_ANALYZER_MODEL_LABORATORY_MODEL_H_
 
 #include "DataReader/data_reader.h"
+#include "DataReader/follow_reader.h"
+#include "DataReader/sample_cache.h"
 #include "LaboratoryEngine/laboratory_engine.h"
+#include "Profiler/stage_profiler.h"
 
 #include <memory>
 
@@ -21,22 +24,167 @@ namespace s21 {
     /**
      * @class LaboratoryModel class\n
      * Объединяет функционал NormalDistributionStatisticReader и LaboratoryStatisticEngine классов\n
+     * После сортировки считанной с файла выборки она сохраняется в SampleCache рядом с исходным файлом,\n
+     * повторное чтение того же неизмененного файла берет значения, упорядоченность и моменты из кэша\n
+     * Из CSV/TSV файла читается столбец, выбранный setReadColumns(), кэш хранится отдельно для каждого столбца\n
+     * Запись чисел (десятичная запятая, разделители групп) по умолчанию определяется по началу файла,\n
+     * при явно заданной setNumberFormat() записи кэш не используется\n
+     * Кэш пишется только для файла, прочитанного без некорректных значений (ни остановки, ни пропусков)\n
+     * Дописываемый файл читается followStatisticFile(), новые значения добавляются в выборку pollFollowedFile()\n
      * Moveable, non-copyable, final class
      */
     class LaboratoryModel final {
         using statistic_type = LaboratoryStatisticEngine::statistic_type;
         using statistic_value_type = LaboratoryStatisticEngine::statistic_value_type;
         using statistic_size_type = LaboratoryStatisticEngine::statistic_size_type;
+        using interval_range_type = LaboratoryStatisticEngine::interval_range_type;
 
     public:
         void readStatisticFromFile(const std::string &path) {
-            auto statistic = s21::NormalDistributionStatisticReader::read(path);
+            follow_reader_.reset();
+            pending_cache_path_.clear();
+            std::string cache_key = cacheKey(path);
+            bool use_cache = sample_cache_enabled_ and !read_options_.number_format;
+            if (use_cache) {
+                S21_PROFILE_SCOPE("cache load");
+                if (auto entry = SampleCache::load(path, cache_key)) {
+                    S21_PROFILE_COUNT(entry->statistic.size());
+                    read_report_ = ReadReport{};
+                    read_report_.values = read_report_.estimated_values = entry->statistic.size();
+                    read_report_.number_format = entry->number_format;
+                    engine_->restoreStatistic(std::move(entry->statistic), entry->sorted, entry->moments);
+                    return;
+                }
+            }
+            auto statistic = s21::NormalDistributionStatisticReader::read(path, read_options_, read_report_);
             engine_->statistic(std::move(statistic));
+            if (use_cache and engine_->isGood() and !read_report_.binary and !read_report_.decompression_failed
+                and !read_report_.stopped and !read_report_.skipped) {
+                pending_cache_path_ = path;
+                pending_cache_key_ = std::move(cache_key);
+            }
         }
 
-        void sortStatistic() { engine_->sortStatistic(); }
+        /**
+         * @brief followStatisticFile
+         * Читает файл и начинает следить за ним: дальнейшие pollFollowedFile() разбирают только дописанные байты\n
+         * Выборка дописываемого файла в кэш не записывается
+         * @return
+         * false, если файл сжат и следить за ним нельзя (выборка при этом не меняется)
+         */
+        bool followStatisticFile(const std::string &path) {
+            auto follow_reader = std::make_unique<FollowReader>(path, read_options_);
+            statistic_type statistic;
+            follow_reader->poll(statistic);
+            if (follow_reader->failed())
+                return false;
+            pending_cache_path_.clear();
+            follow_reader_ = std::move(follow_reader);
+            read_report_ = follow_reader_->report();
+            engine_->statistic(std::move(statistic));
+            return true;
+        }
+
+        /**
+         * @brief pollFollowedFile
+         * Добавляет в выборку значения, дописанные в файл после прошлого чтения,\n
+         * перезаписанный (укоротившийся) файл читается заново
+         * @return
+         * Изменилась ли выборка
+         */
+        bool pollFollowedFile() {
+            if (!follow_reader_)
+                return false;
+            statistic_type statistic;
+            if (!follow_reader_->poll(statistic))
+                engine_->statistic(std::move(statistic));
+            else if (!statistic.empty())
+                engine_->appendStatistic(statistic);
+            else
+                return false;
+            read_report_ = follow_reader_->report();
+            return true;
+        }
+
+        void stopFollowing() noexcept { follow_reader_.reset(); }
+        bool isFollowing() const noexcept { return static_cast<bool>(follow_reader_); }
+
+        /**
+         * @brief getColumnNames
+         * Имена столбцов CSV/TSV файла (для файла без заголовка - номера столбцов "1", "2", ...),\n
+         * пустой список, если файл не табличный
+         */
+        std::vector<std::string> getColumnNames(const std::string &path) const {
+            if (!NormalDistributionStatisticReader::isDelimited(path, read_options_))
+                return {};
+            return NormalDistributionStatisticReader::readHeader(path, read_options_);
+        }
+
+        /**
+         * Пустой список - первый числовой столбец файла
+         */
+        void setReadColumns(std::vector<std::string> columns) { read_options_.columns = std::move(columns); }
+
+        /**
+         * std::nullopt - запись определяется по первому блоку файла (по умолчанию)
+         */
+        void setNumberFormat(std::optional<NumberFormat> number_format) noexcept { read_options_.number_format = number_format; }
+
+        /**
+         * true - некорректные значения пропускаются, их количество и позиции - в getReadReport()\n
+         * false - чтение прекращается на первом некорректном значении (по умолчанию)
+         */
+        void setSkipInvalidValues(bool skip) noexcept {
+            read_options_.invalid_values = skip ? InvalidValues::kSkip : InvalidValues::kStop;
+        }
+
+        void setSampleCacheEnabled(bool enabled) noexcept { sample_cache_enabled_ = enabled; }
+
+        /**
+         * @brief streamStatisticSummary
+         * Сводные характеристики файла за один потоковый проход, выборка в память не загружается\n
+         * и текущая выборка модели не меняется
+         */
+        StatisticSummary streamStatisticSummary(const std::string &path) const {
+            MomentAccumulator moments;
+            NormalDistributionStatisticReader::stream(path, [&moments](const double *data, std::size_t size) {
+                moments.push(data, size);
+            }, read_options_);
+            return moments.summary();
+        }
+
+        /**
+         * @brief streamStatisticHistogram
+         * Гистограмма файла с bins_count равными корзинами за два потоковых прохода:\n
+         * первый находит минимум и максимум, второй раскладывает значения по корзинам
+         */
+        StatisticHistogram streamStatisticHistogram(const std::string &path, const statistic_size_type &bins_count) const {
+            StatisticSummary summary = streamStatisticSummary(path);
+            StatisticHistogram histogram(summary.minimum, summary.maximum, bins_count);
+            if (summary.count)
+                NormalDistributionStatisticReader::stream(path, [&histogram](const double *data, std::size_t size) {
+                    histogram.push(data, size);
+                }, read_options_);
+            return histogram;
+        }
+
+        void setReadThreadsCount(const statistic_size_type &threads_count) noexcept { read_options_.threads_count = threads_count; }
+
+        void sortStatistic() {
+            engine_->sortStatistic();
+            if (!pending_cache_path_.empty()) {
+                S21_PROFILE_SCOPE("cache save");
+                S21_PROFILE_COUNT(engine_->statisticSize());
+                SampleCache::save(pending_cache_path_, engine_->statistic(), engine_->isSorted(), engine_->statisticMoments(),
+                                  read_report_.number_format, pending_cache_key_);
+                pending_cache_path_.clear();
+            }
+        }
+        void setSortBackend(StatisticSorter::Backend backend) { engine_->sorter().backend(backend); }
+        void setSortThreadsCount(const statistic_size_type &threads_count) { engine_->sorter().threadsCount(threads_count); }
 
         void buildStatisticIntervals(const statistic_size_type &intervals_count) {
+            sortStatistic();
             engine_->intervalsCount(intervals_count);
             engine_->buildIntervals();
         }
@@ -47,21 +195,43 @@ namespace s21 {
         statistic_value_type getStatisticMeanValue() const { return engine_->statisticMean(); }
         statistic_value_type getStatisticMeanQuadraticDeviationValue() const { return engine_->statisticMeanQuadraticDeviation(); }
         statistic_value_type getStatisticSum() const { return engine_->statisticSum(); }
+        StatisticSummary getStatisticSummary() const { return engine_->statisticSummary(); }
+        const ReadReport &getReadReport() const noexcept { return read_report_; }
+        StatisticHistogram getStatisticHistogram(const statistic_size_type &bins_count) const { return engine_->statisticHistogram(bins_count); }
         statistic_size_type  getStatisticSize() const noexcept { return engine_->statisticSize(); }
         statistic_size_type  getStatisticIntervalsCount() const noexcept { return engine_->intervalsCount(); }
+        const std::vector<std::pair<statistic_value_type, statistic_value_type>> &getIntervalsBorderValues() const noexcept { return engine_->intervalsBorderValues(); }
+        const std::vector<interval_range_type> &getStatisticIntervals() const noexcept { return engine_->statisticIntervals(); }
+        const statistic_type &getIntervalsRelativeAmount() const noexcept { return engine_->intervalsRelativeAmount(); }
         const statistic_type &getStatistic() const noexcept { return engine_->statistic(); }
         statistic_value_type getStatisticMinimumValue() const noexcept { return engine_->statisticMinimumValue(); }
         statistic_value_type getStatisticMaximumValue() const noexcept { return engine_->statisticMaximumValue(); }
-        std::pair<statistic_type, statistic_type> getGraphStatisticData() const { return engine_->graphStatisticData(); }
-        std::pair<statistic_type, statistic_type> getGraphNormalDistributionData() const { return engine_->graphNormalDistributionData(); }
+        const std::pair<statistic_type, statistic_type> &getGraphStatisticData() const { return engine_->graphStatisticData(); }
+        const std::pair<statistic_type, statistic_type> &getGraphNormalDistributionData() const { return engine_->graphNormalDistributionData(); }
 
         bool statisticIsGood() const noexcept { return engine_->isGood(); }
 
-        void eraseStatisticValue(const statistic_value_type &value) { engine_->eraseStatisticValue(value); }
+        void eraseStatisticValue(const statistic_value_type &value) {
+            pending_cache_path_.clear(); // Выборка больше не совпадает с файлом
+            engine_->eraseStatisticValue(value);
+        }
 
 
     private:
         std::unique_ptr<LaboratoryStatisticEngine> engine_{new LaboratoryStatisticEngine};
+        ReadOptions read_options_;
+        ReadReport read_report_;
+        bool sample_cache_enabled_ = true;
+        std::string pending_cache_path_; // Файл, кэш которого будет записан после сортировки
+        std::string pending_cache_key_;
+        std::unique_ptr<FollowReader> follow_reader_;
+
+    private:
+        std::string cacheKey(const std::string &path) const {
+            if (read_options_.columns.empty() or !NormalDistributionStatisticReader::isDelimited(path, read_options_))
+                return {};
+            return read_options_.columns.front();
+        }
     };
 }
 
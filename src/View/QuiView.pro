@@ -8,6 +8,19 @@ CONFIG += c++17
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# Reading of .gz and .zst sample files, e.g. qmake CONFIG+=s21_zlib CONFIG+=s21_zstd
+s21_zlib {
+    DEFINES += S21_WITH_ZLIB
+    LIBS += -lz
+}
+s21_zstd {
+    DEFINES += S21_WITH_ZSTD
+    LIBS += -lzstd
+}
+
+# Stage timers compiled out, e.g. qmake CONFIG+=s21_no_profiling
+s21_no_profiling: DEFINES += S21_NO_PROFILING
+
 SOURCES += \
     ../main.cpp \
     laboratoryview.cpp \
@@ -16,7 +29,21 @@ SOURCES += \
 HEADERS += \
     ../Controller/laboratory_controller.h \
     ../Model/DataReader/data_reader.h \
+    ../Model/DataReader/decompressor.h \
+    ../Model/DataReader/delimited_parser.h \
+    ../Model/DataReader/follow_reader.h \
+    ../Model/DataReader/mapped_file.h \
+    ../Model/DataReader/number_parser.h \
+    ../Model/DataReader/parse_errors.h \
+    ../Model/DataReader/sample_cache.h \
     ../Model/LaboratoryEngine/laboratory_engine.h \
+    ../Model/LaboratoryEngine/moment_accumulator.h \
+    ../Model/LaboratoryEngine/simd_kernels.h \
+    ../Model/LaboratoryEngine/statistic_histogram.h \
+    ../Model/LaboratoryEngine/statistic_sorter.h \
+    ../Model/Profiler/allocation_counter.h \
+    ../Model/Profiler/stage_profiler.h \
+    ../Model/ThreadPool/thread_pool.h \
     ../Model/laboratory_model.h \
     laboratoryview.h \
     qcustomplot.h
@@ -12,18 +12,29 @@
 #include "laboratoryview.h"
 #include "ui_laboratoryview.h"
 
+#include <QLabel>
+#include <QTimer>
+#include <QFileInfo>
 #include <QFileDialog>
+#include <QInputDialog>
 #include <QMessageBox>
+#include <QFileSystemWatcher>
+
+#include <sstream>
 
 LaboratoryView::LaboratoryView(QWidget *parent) 
-    : QMainWindow(parent) , ui(new Ui::LaboratoryView) , controller_(new s21::LaboratoryController) {
+    : QMainWindow(parent) , ui(new Ui::LaboratoryView) , controller_(new s21::LaboratoryController),
+      file_watcher_(new QFileSystemWatcher(this)), follow_timer_(new QTimer(this)), profile_label_(new QLabel(this)) {
     ui->setupUi(this);
+    ui->statusbar->addWidget(profile_label_, 1);
     ui->graph->setInteraction(QCP::iRangeZoom, true);
     ui->graph->setInteraction(QCP::iRangeDrag, true);
     setWindowIcon(QIcon(":/icon.png"));
     setWindowTitle("Statistic analyzer");
     setGraphTheme();
     setToolTips();
+    connect(file_watcher_, &QFileSystemWatcher::fileChanged, this, &LaboratoryView::pollFollowedFile);
+    connect(follow_timer_, &QTimer::timeout, this, &LaboratoryView::pollFollowedFile);
 }
 
 LaboratoryView::~LaboratoryView() {
@@ -35,25 +46,78 @@ void LaboratoryView::on_loadStatisticPushButton_clicked() {
     auto file_path = QFileDialog::getOpenFileName(this, "Выберите файл с выборкой");
     if (file_path.isEmpty())
         return;
+    s21::ProfileSession session(profile_);
+    ui->followFilePushButton->setChecked(false);
+    loaded_file_path_.clear();
+    auto columns = controller_->getColumnNames(file_path.toStdString());
+    if (columns.size() > 1) {
+        QStringList items;
+        for (const auto &column : columns)
+            items << QString::fromStdString(column);
+        bool selected = false;
+        auto column = QInputDialog::getItem(this, "Выбор столбца", "Столбец с выборкой:", items, 0, false, &selected);
+        if (!selected)
+            return;
+        controller_->setReadColumns({column.toStdString()});
+    } else {
+        controller_->setReadColumns({});
+    }
     controller_->readStatisticFromFile(file_path.toStdString());
     controller_->sortStatistic();
+    const auto &report = controller_->getReadReport();
     if (controller_->statisticIsGood()) {
         statistic_is_read_ = true;
-        QMessageBox::information(this, "Статус считанности", "Выборка была считана успешно!");
+        loaded_file_path_ = file_path;
+        QString message = "Выборка была считана успешно!";
+        if (!report.number_format.isDefault()) {
+            message += QString("\nДесятичный разделитель: '%1'").arg(QChar(report.number_format.decimal));
+            if (report.number_format.thousands)
+                message += QString(", разделитель разрядов: '%1'").arg(QChar(report.number_format.thousands));
+        }
+        if (report.decompression_failed)
+            QMessageBox::warning(this, "Статус считанности", "Сжатый файл поврежден, считана только распакованная часть выборки!"
+                                                             + invalidValuesMessage(report));
+        else if (report.skipped)
+            QMessageBox::warning(this, "Статус считанности", message + invalidValuesMessage(report));
+        else
+            QMessageBox::information(this, "Статус считанности", message);
         setReadData();
+    } else if (report.decompression_failed) {
+        QMessageBox::information(this, "Статус считанности", s21::compressionSupported(report.compression)
+                                                             ? "Выборка была считана неудачно! (Сжатый файл поврежден)"
+                                                             : "Выборка была считана неудачно! (Сжатие не поддерживается сборкой)");
     } else {
-        QMessageBox::information(this, "Статус считанности", "Выборка была считана неудачно! (Некорректные данные в файле)");
+        QMessageBox::information(this, "Статус считанности", "Выборка была считана неудачно! (Некорректные данные в файле)"
+                                                             + invalidValuesMessage(report));
+    }
+    showProfile();
+}
+
+QString LaboratoryView::invalidValuesMessage(const s21::ReadReport &report) const {
+    if (!report.skipped)
+        return {};
+    QString message = QString("\n\nПропущено некорректных значений: %1").arg(report.skipped);
+    constexpr std::size_t kShownErrors = 5;
+    for (std::size_t index = 0; index != report.errors.size() and index != kShownErrors; ++index) {
+        const auto &error = report.errors[index];
+        message += QString("\nстрока %1, столбец %2: \"%3\"").arg(error.line).arg(error.column)
+                                                              .arg(QString::fromStdString(error.token));
     }
+    if (report.skipped > kShownErrors)
+        message += "\n...";
+    return message;
 }
 
 void LaboratoryView::on_intervalsBuildPushButton_clicked() {
     if (!statistic_is_read_)
         return;
+    s21::ProfileSession session(profile_);
     auto intervals_count = static_cast<statistic_size_type>(ui->intervals_count->value());
     controller_->buildStatisticIntervals(intervals_count);
     statistic_intervals_built_ = true;
     QMessageBox::information(this, "Интервалы", "Выборка была успешно разбита на интервалы!");
     buildStatisticGraph();
+    showProfile();
 }
 
 void LaboratoryView::on_getStatisticIntervalsPushButton_clicked() {
@@ -84,25 +148,83 @@ void LaboratoryView::on_saveSortedStatisticPushButton_clicked() {
     fout.close();
 }
 
+void LaboratoryView::on_skipInvalidCheckBox_toggled(bool checked) {
+    controller_->setSkipInvalidValues(checked);
+}
+
+void LaboratoryView::on_followFilePushButton_toggled(bool checked) {
+    if (!checked) {
+        follow_timer_->stop();
+        if (!file_watcher_->files().isEmpty())
+            file_watcher_->removePaths(file_watcher_->files());
+        controller_->stopFollowing();
+        return;
+    }
+    s21::ProfileSession session(profile_);
+    if (loaded_file_path_.isEmpty() or !controller_->followStatisticFile(loaded_file_path_.toStdString())) {
+        QMessageBox::information(this, "Слежение за файлом", loaded_file_path_.isEmpty() ? "Сначала загрузите выборку из файла"
+                                                                                          : "За сжатым файлом следить нельзя");
+        ui->followFilePushButton->setChecked(false);
+        return;
+    }
+    file_watcher_->addPath(loaded_file_path_);
+    follow_timer_->start(kFollowPollInterval);
+    updateFollowedStatistic();
+    showProfile();
+}
+
+void LaboratoryView::pollFollowedFile() {
+    // Файл, пересозданный записывающей программой, пропадает из watcher
+    if (!file_watcher_->files().contains(loaded_file_path_) and QFileInfo::exists(loaded_file_path_))
+        file_watcher_->addPath(loaded_file_path_);
+    s21::ProfileSession session(profile_);
+    if (!controller_->pollFollowedFile())
+        return;
+    updateFollowedStatistic();
+    showProfile();
+}
+
+void LaboratoryView::updateFollowedStatistic() {
+    controller_->sortStatistic();
+    statistic_is_read_ = controller_->statisticIsGood();
+    if (!statistic_is_read_)
+        return;
+    setReadData();
+    if (!statistic_intervals_built_)
+        return;
+    try {
+        controller_->buildStatisticIntervals(static_cast<statistic_size_type>(ui->intervals_count->value()));
+    } catch (const std::runtime_error &) { // Перезаписанный файл может не иметь разброса значений
+        statistic_intervals_built_ = false;
+        return;
+    }
+    bool normal_distribution_is_built = normal_distribution_is_built_;
+    normal_distribution_is_built_ = false;
+    buildStatisticGraph();
+    if (normal_distribution_is_built)
+        on_addNormalDistributionGraphPushButton_clicked();
+}
+
 void LaboratoryView::setReadData() {
-    ui->label_statistic_size->setText(QString::number(controller_->getStatisticSize()));
-    ui->label_statistic_mean->setText(QString::number(controller_->getStatisticMeanValue()));
-    auto quadratic_deviation = controller_->getStatisticMeanQuadraticDeviationValue();
-    ui->label_statistic_deviation->setText(QString::number(quadratic_deviation));
-    ui->label_statistic_dispersion->setText(QString::number(std::pow(quadratic_deviation, 2)));
-    ui->label_statistic_min_value->setText(QString::number(controller_->getStatisticMinimumValue()));
-    ui->label_statistic_max_value->setText(QString::number(controller_->getStatisticMaximumValue()));
-    ui->label_statistic_sum->setText(QString::number(controller_->getStatisticSum()));
+    auto summary = controller_->getStatisticSummary();
+    ui->label_statistic_size->setText(QString::number(summary.count));
+    ui->label_statistic_mean->setText(QString::number(summary.mean));
+    ui->label_statistic_deviation->setText(QString::number(std::sqrt(summary.variance)));
+    ui->label_statistic_dispersion->setText(QString::number(summary.variance));
+    ui->label_statistic_min_value->setText(QString::number(summary.minimum));
+    ui->label_statistic_max_value->setText(QString::number(summary.maximum));
+    ui->label_statistic_sum->setText(QString::number(summary.sum));
 }
 
 void LaboratoryView::buildStatisticGraph() {
     if (!statistic_intervals_built_)
         return;
-    auto [x1_points, y1_points] = controller_->getGraphStatisticData();
+    S21_PROFILE_SCOPE("graph");
+    const auto &[x1_points, y1_points] = controller_->getGraphStatisticData();
     if (x1_points.empty())
         return;
     ui->graph->clearGraphs();
-    ui->graph->replot();
+    replot();
     double step = 0.05;
     ui->graph->xAxis->setRange(x1_points.front() - step, x1_points.back() + step);
     ui->graph->yAxis->setRange(0, *(std::max_element(y1_points.begin(), y1_points.end())) + step);
@@ -110,38 +232,66 @@ void LaboratoryView::buildStatisticGraph() {
     ui->graph->addGraph()->setPen(QPen(QColor( 66, 135, 245)));
     ui->graph->graph(0)->setLineStyle(QCPGraph::lsLine);
     ui->graph->graph(0)->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssDisc, 5));
-    for (statistic_size_type current = 0, size = x1_points.size(); current != size; ++current)
-        ui->graph->graph(0)->addData(x1_points[current], y1_points[current]);
+    {
+        S21_PROFILE_SCOPE("points");
+        S21_PROFILE_COUNT(x1_points.size());
+        for (statistic_size_type current = 0, size = x1_points.size(); current != size; ++current)
+            ui->graph->graph(0)->addData(x1_points[current], y1_points[current]);
+    }
     ui->graph->graph(0)->setName("Практическое распределение");
-    ui->graph->replot();
+    replot();
 }
 
 void LaboratoryView::on_addNormalDistributionGraphPushButton_clicked() {
     if (!statistic_intervals_built_)
         return;
+    s21::ProfileSession session(profile_);
     if (!normal_distribution_is_built_) {
-        auto [x2_points, y2_points] = controller_->getGraphNormalDistributionData();
+        S21_PROFILE_SCOPE("normal graph");
+        const auto &[x2_points, y2_points] = controller_->getGraphNormalDistributionData();
 
         ui->graph->addGraph()->setPen(QPen(QColor(245, 66, 126)));
-        for (statistic_size_type current = 0, size = x2_points.size(); current != size; ++current)
+        {
+            S21_PROFILE_SCOPE("points");
+            S21_PROFILE_COUNT(x2_points.size());
+            for (statistic_size_type current = 0, size = x2_points.size(); current != size; ++current)
                 ui->graph->graph(1)->addData(x2_points[current], y2_points[current]);
+        }
         ui->graph->graph(1)->setName("Нормальное распределение");
-        ui->graph->replot();
+        replot();
         normal_distribution_is_built_ = true;
     } else {
         buildStatisticGraph();
         normal_distribution_is_built_ = false;
     }
+    showProfile();
 }
 
 void LaboratoryView::on_eraseStatisticValuePushButton_clicked() {
     if (!statistic_is_read_)
         return;
+    s21::ProfileSession session(profile_);
     normal_distribution_is_built_ = false;
     controller_->eraseStatisticValue(ui->erase_value_line_edit->text().toDouble());
     on_intervalsBuildPushButton_clicked();
     on_addNormalDistributionGraphPushButton_clicked();
     setReadData();
+    showProfile();
+}
+
+void LaboratoryView::replot() {
+    S21_PROFILE_SCOPE("replot");
+    ui->graph->replot();
+}
+
+void LaboratoryView::showProfile() {
+    if (profile_.empty())
+        return;
+    profile_label_->setText(QString("Последнее действие: %1 (всего %2 ms)").arg(QString::fromStdString(profile_.summary()))
+                                                        .arg(static_cast<double>(profile_.nanoseconds()) / 1e6, 0, 'f', 1));
+    std::ostringstream report;
+    profile_.report(report);
+    profile_label_->setToolTip("<pre>" + QString::fromStdString(report.str()).toHtmlEscaped() + "</pre>");
 }
 
 void LaboratoryView::setGraphTheme() {
@@ -161,7 +311,9 @@ void LaboratoryView::setGraphTheme() {
 
 void LaboratoryView::setToolTips() {
     ui->loadStatisticPushButton->setToolTip("Загрузить выборку и файла");
+    ui->followFilePushButton->setToolTip("Следить за загруженным файлом: дописанные в него значения сразу добавляются в выборку");
     ui->saveSortedStatisticPushButton->setToolTip("Сохраняет загруженную выборку в файл в отсортированном виде");
+    ui->skipInvalidCheckBox->setToolTip("Пропускать некорректные значения при загрузке (с указанием их строк) вместо остановки на первом из них");
     ui->intervalsBuildPushButton->setToolTip("Разбивает выборку на n-количество разных интервалов, и стоит практический график распределения");
     ui->getStatisticIntervalsPushButton->setToolTip("Сохраняет разбитую выботку на n-интервалов в файл");
     ui->addNormalDistributionGraphPushButton->setToolTip("Добавляет к графику практического распределения график нормального распределения");
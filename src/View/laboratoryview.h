@@ -19,6 +19,9 @@
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class LaboratoryView; }
+class QFileSystemWatcher;
+class QTimer;
+class QLabel;
 QT_END_NAMESPACE
 
 class LaboratoryView final : public QMainWindow {
@@ -42,19 +45,33 @@ private slots:
     void on_saveSortedStatisticPushButton_clicked();
     void on_addNormalDistributionGraphPushButton_clicked();
     void on_eraseStatisticValuePushButton_clicked();
+    void on_skipInvalidCheckBox_toggled(bool checked);
+    void on_followFilePushButton_toggled(bool checked);
+    void pollFollowedFile();
 
 private:
     Ui::LaboratoryView *ui;
     s21::LaboratoryController *controller_;
+    QFileSystemWatcher *file_watcher_;
+    QTimer *follow_timer_;
+    QLabel *profile_label_;
+    QString loaded_file_path_;
+    s21::StageProfile profile_; // Стадии последнего действия, показываются в строке состояния
 
     bool statistic_is_read_ = false;
     bool statistic_intervals_built_ = false;
     bool normal_distribution_is_built_ = false;
 
+    static constexpr int kFollowPollInterval = 1000; // Опрос файла на случай, если watcher не видит запись (сетевой диск), мс
+
     void setReadData();
+    void updateFollowedStatistic();
     void buildStatisticGraph();
+    void replot();
+    void showProfile();
     void setGraphTheme();
     void setToolTips();
+    QString invalidValuesMessage(const s21::ReadReport &report) const;
 
     using statistic_type = s21::LaboratoryController::statistic_type;
     using statistic_value_type = s21::LaboratoryController::statistic_value_type;
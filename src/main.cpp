@@ -10,6 +10,7 @@
  */
 
 #include "./View/laboratoryview.h"
+#include "./Model/Profiler/allocation_counter.h"
 
 #include <QApplication>
 